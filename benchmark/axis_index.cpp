@@ -6,7 +6,16 @@
 
 #include <benchmark/benchmark.h>
 #include <boost/histogram/axis.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
 #include <numeric>
+#include <random>
+#include <ratio>
+#include <string>
+#include <utility>
+#include <vector>
 #include "../test/throw_exception.hpp"
 #include "generator.hpp"
 
@@ -24,6 +33,39 @@ static void regular(benchmark::State& state) {
   auto a = axis::regular<>(100, 0.0, 1.0);
   generator<Distribution> gen;
   for (auto _ : state) benchmark::DoNotOptimize(a.index(gen()));
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <class Distribution>
+static void static_regular(benchmark::State& state) {
+  auto a = axis::static_regular<100, std::ratio<0>, std::ratio<1>>();
+  generator<Distribution> gen;
+  for (auto _ : state) benchmark::DoNotOptimize(a.index(gen()));
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <class Distribution>
+static void static_regular_n(benchmark::State& state) {
+  auto a = axis::static_regular<100, std::ratio<0>, std::ratio<1>>();
+  generator<Distribution, 1 << 12> gen;
+  std::vector<axis::index_type> out(1 << 12);
+  for (auto _ : state) {
+    a.index_n(gen.buffer_, out.data(), out.size());
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * out.size());
+}
+
+template <class Distribution>
+static void regular_n(benchmark::State& state) {
+  auto a = axis::regular<>(100, 0.0, 1.0);
+  generator<Distribution, 1 << 12> gen;
+  std::vector<axis::index_type> out(1 << 12);
+  for (auto _ : state) {
+    a.index_n(gen.buffer_, out.data(), out.size());
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * out.size());
 }
 
 template <class Distribution>
@@ -49,6 +91,169 @@ static void variable(benchmark::State& state) {
   for (auto _ : state) benchmark::DoNotOptimize(a.index(gen()));
 }
 
+// log-spaced edges from 1 to 1000, values are uniform in the logarithm
+static void variable_log(benchmark::State& state) {
+  const auto n = static_cast<int>(state.range(0));
+  std::vector<double> v;
+  for (int i = 0; i <= n; ++i) v.push_back(std::pow(10, 3.0 * i / n));
+  auto a = axis::variable<>(v);
+  generator<uniform, 1 << 12> gen;
+  std::vector<double> x(gen.buffer_, gen.buffer_ + (1 << 12));
+  for (auto&& xi : x) xi = std::pow(10, 3 * xi);
+  std::size_t i = 0;
+  for (auto _ : state) benchmark::DoNotOptimize(a.index(x[i++ % x.size()]));
+}
+
+// latencies from 1 microsecond to 100 seconds, uniform in the logarithm
+static std::vector<double> latencies() {
+  generator<uniform, 1 << 12> gen;
+  std::vector<double> x(gen.buffer_, gen.buffer_ + (1 << 12));
+  for (auto&& xi : x) xi = std::pow(10, 8 * xi - 6);
+  return x;
+}
+
+template <class Transform>
+static void regular_log(benchmark::State& state) {
+  auto a = axis::regular<double, Transform>(256, 1e-6, 100);
+  const auto x = latencies();
+  std::size_t i = 0;
+  for (auto _ : state) benchmark::DoNotOptimize(a.index(x[i++ % x.size()]));
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <class Transform>
+static void regular_log_n(benchmark::State& state) {
+  auto a = axis::regular<double, Transform>(256, 1e-6, 100);
+  const auto x = latencies();
+  std::vector<axis::index_type> out(x.size());
+  for (auto _ : state) {
+    a.index_n(x.data(), out.data(), out.size());
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * out.size());
+}
+
+template <class T>
+static void log_linear(benchmark::State& state) {
+  auto a = axis::log_linear<T>(3, static_cast<T>(1e-6), 100);
+  const auto v = latencies();
+  const std::vector<T> x(v.begin(), v.end());
+  std::size_t i = 0;
+  for (auto _ : state) benchmark::DoNotOptimize(a.index(x[i++ % x.size()]));
+  state.SetItemsProcessed(state.iterations());
+}
+
+static void log_linear_ns(benchmark::State& state) {
+  auto a = axis::log_linear<std::uint64_t>(3, 1000, 100000000000);
+  const auto v = latencies();
+  std::vector<std::uint64_t> x;
+  for (auto&& vi : v) x.push_back(static_cast<std::uint64_t>(vi * 1e9));
+  std::size_t i = 0;
+  for (auto _ : state) benchmark::DoNotOptimize(a.index(x[i++ % x.size()]));
+  state.SetItemsProcessed(state.iterations());
+}
+
+// nanoseconds up to 100 seconds
+static std::vector<std::int64_t> timestamps() {
+  generator<uniform, 1 << 12> gen;
+  std::vector<std::int64_t> x;
+  for (auto&& xi : gen.buffer_) x.push_back(static_cast<std::int64_t>(xi * 1e11));
+  return x;
+}
+
+static void regular_ns(benchmark::State& state) {
+  auto a = axis::regular<>(1000, 0, 1e11);
+  const auto x = timestamps();
+  for (auto _ : state)
+    for (auto&& xi : x) benchmark::DoNotOptimize(a.index(static_cast<double>(xi)));
+  state.SetItemsProcessed(state.iterations() * x.size());
+}
+
+// bins of 100 ms, or of 2^27 ns if Pow2 is true
+template <bool Pow2>
+static void integer_regular_ns(benchmark::State& state) {
+  auto a = axis::integer_regular<std::int64_t>(
+      1000, 0, Pow2 ? std::int64_t{1000} << 27 : std::int64_t{100000000000});
+  const auto x = timestamps();
+  for (auto _ : state)
+    for (auto&& xi : x) benchmark::DoNotOptimize(a.index(xi));
+  state.SetItemsProcessed(state.iterations() * x.size());
+}
+
+static void integer_regular_time_point(benchmark::State& state) {
+  using ns = std::chrono::nanoseconds;
+  using time_point = std::chrono::time_point<std::chrono::system_clock, ns>;
+  auto a = axis::integer_regular<time_point>(1000, time_point{},
+                                             time_point{ns{100000000000}});
+  std::vector<time_point> x;
+  for (auto&& xi : timestamps()) x.emplace_back(ns{xi});
+  for (auto _ : state)
+    for (auto&& xi : x) benchmark::DoNotOptimize(a.index(xi));
+  state.SetItemsProcessed(state.iterations() * x.size());
+}
+
+// regular edges in [0, 1] and three wide bins up to 10
+template <class Distribution>
+static void variable_tail(benchmark::State& state) {
+  std::vector<double> v;
+  for (double x = 0; x <= state.range(0); ++x) v.push_back(x / state.range(0));
+  for (double x : {2, 5, 10}) v.push_back(x);
+  auto a = axis::variable<>(v);
+  generator<Distribution> gen;
+  for (auto _ : state) benchmark::DoNotOptimize(a.index(gen()));
+}
+
+// slow random walk in [0, 1], like a time-ordered sensor signal
+static std::vector<double> random_walk(std::size_t n, double step) {
+  std::default_random_engine rng(1);
+  std::normal_distribution<> dis(0, step);
+  std::vector<double> x(n);
+  double z = 0.5;
+  for (auto&& xi : x) {
+    z += dis(rng);
+    z -= std::floor(z);
+    xi = z;
+  }
+  return x;
+}
+
+static void variable_walk(benchmark::State& state) {
+  std::vector<double> v;
+  for (double x = 0; x <= state.range(0); ++x) v.push_back(x * x / state.range(0) / state.range(0));
+  auto a = axis::variable<>(v);
+  const auto x = random_walk(1 << 12, 1e-3);
+  std::size_t i = 0;
+  for (auto _ : state) benchmark::DoNotOptimize(a.index(x[i++ % x.size()]));
+  state.SetItemsProcessed(state.iterations());
+}
+
+static void variable_walk_n(benchmark::State& state) {
+  std::vector<double> v;
+  for (double x = 0; x <= state.range(0); ++x) v.push_back(x * x / state.range(0) / state.range(0));
+  auto a = axis::variable<>(v);
+  const auto x = random_walk(1 << 12, 1e-3);
+  std::vector<axis::index_type> out(x.size());
+  for (auto _ : state) {
+    a.index_n(x.data(), out.data(), out.size());
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * out.size());
+}
+
+template <class Distribution>
+static void variable_n(benchmark::State& state) {
+  std::vector<double> v;
+  for (double x = 0; x <= state.range(0); ++x) v.push_back(x * x / state.range(0) / state.range(0));
+  auto a = axis::variable<>(v);
+  generator<Distribution, 1 << 12> gen;
+  std::vector<axis::index_type> out(1 << 12);
+  for (auto _ : state) {
+    a.index_n(gen.buffer_, out.data(), out.size());
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * out.size());
+}
+
 static void category(benchmark::State& state) {
   std::vector<int> v(state.range(0));
   std::iota(v.begin(), v.end(), 0);
@@ -57,14 +262,102 @@ static void category(benchmark::State& state) {
   for (auto _ : state) benchmark::DoNotOptimize(a.index(gen()));
 }
 
+static void category_string(benchmark::State& state) {
+  // generator draws from [0, n], the last value is not on the axis
+  std::vector<std::string> v;
+  for (int i = 0; i <= state.range(0); ++i) v.push_back("host" + std::to_string(i));
+  auto a = axis::category<std::string>(v.begin(), v.end() - 1);
+  generator<uniform_int> gen(static_cast<int>(state.range(0)));
+  for (auto _ : state)
+    benchmark::DoNotOptimize(a.index(v[static_cast<std::size_t>(gen())]));
+}
+
+// histogram converts arguments with axis::traits::index
+static void category_cstring(benchmark::State& state) {
+  std::vector<std::string> v;
+  for (int i = 0; i <= state.range(0); ++i)
+    v.push_back("host" + std::to_string(i) + ".example.com");
+  auto a = axis::category<std::string>(v.begin(), v.end() - 1);
+  generator<uniform_int> gen(static_cast<int>(state.range(0)));
+  for (auto _ : state) {
+    const char* x = v[static_cast<std::size_t>(gen())].c_str();
+    benchmark::DoNotOptimize(axis::traits::index(a, x));
+  }
+}
+
+// values come in runs of equal values if run > 1
+template <bool Batch>
+static void category_string_runs(benchmark::State& state) {
+  std::vector<std::string> v;
+  for (int i = 0; i < state.range(0); ++i) v.push_back("host" + std::to_string(i));
+  auto a = axis::category<std::string>(v);
+  std::default_random_engine rng(1);
+  std::uniform_int_distribution<std::size_t> dis(0, v.size() - 1);
+  std::vector<std::string> x(1 << 12);
+  for (std::size_t i = 0; i < x.size(); ++i)
+    x[i] = i % state.range(1) ? x[i - 1] : v[dis(rng)];
+  std::vector<axis::index_type> out(x.size());
+  for (auto _ : state) {
+    if (Batch)
+      a.index_n(x.data(), out.data(), out.size());
+    else
+      for (std::size_t i = 0; i < x.size(); ++i) out[i] = a.index(x[i]);
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * out.size());
+}
+
+// values without std::hash are always searched linearly; the most frequent values are
+// declared last
+static void category_skewed(benchmark::State& state) {
+  using value_type = std::pair<int, int>;
+  const auto n = static_cast<int>(state.range(0));
+  std::vector<value_type> v;
+  for (int i = 0; i < n; ++i) v.emplace_back(i, i);
+  auto a = axis::category<value_type>(v);
+  std::default_random_engine rng(1);
+  std::geometric_distribution<> dis(0.2);
+  std::vector<value_type> x(1 << 12);
+  for (auto&& xi : x) xi = v[n - 1 - std::min(dis(rng), n - 1)];
+  std::size_t i = 0;
+  for (auto _ : state) benchmark::DoNotOptimize(a.index(x[i++ % x.size()]));
+}
+
 BENCHMARK_TEMPLATE(regular, uniform);
 BENCHMARK_TEMPLATE(regular, normal);
+BENCHMARK_TEMPLATE(regular_n, uniform);
+BENCHMARK_TEMPLATE(regular_n, normal);
+BENCHMARK_TEMPLATE(static_regular, uniform);
+BENCHMARK_TEMPLATE(static_regular, normal);
+BENCHMARK_TEMPLATE(static_regular_n, uniform);
+BENCHMARK_TEMPLATE(static_regular_n, normal);
 BENCHMARK_TEMPLATE(circular, uniform);
 BENCHMARK_TEMPLATE(circular, normal);
 BENCHMARK_TEMPLATE(integer, int, uniform);
 BENCHMARK_TEMPLATE(integer, int, normal);
 BENCHMARK_TEMPLATE(integer, double, uniform);
 BENCHMARK_TEMPLATE(integer, double, normal);
+BENCHMARK(regular_ns);
+BENCHMARK_TEMPLATE(integer_regular_ns, false);
+BENCHMARK_TEMPLATE(integer_regular_ns, true);
+BENCHMARK(integer_regular_time_point);
+BENCHMARK_TEMPLATE(regular_log, axis::transform::log);
+BENCHMARK_TEMPLATE(regular_log, axis::transform::fast_log);
+BENCHMARK_TEMPLATE(regular_log_n, axis::transform::log);
+BENCHMARK_TEMPLATE(regular_log_n, axis::transform::fast_log);
+BENCHMARK_TEMPLATE(log_linear, double);
+BENCHMARK_TEMPLATE(log_linear, float);
+BENCHMARK(log_linear_ns);
 BENCHMARK_TEMPLATE(variable, uniform)->RangeMultiplier(10)->Range(10, 10000);
 BENCHMARK_TEMPLATE(variable, normal)->RangeMultiplier(10)->Range(10, 10000);
+BENCHMARK(variable_log)->RangeMultiplier(10)->Range(10, 10000);
+BENCHMARK(variable_walk)->RangeMultiplier(10)->Range(10, 10000);
+BENCHMARK(variable_walk_n)->RangeMultiplier(10)->Range(10, 10000);
+BENCHMARK_TEMPLATE(variable_n, uniform)->RangeMultiplier(10)->Range(10, 10000);
+BENCHMARK_TEMPLATE(variable_tail, normal)->RangeMultiplier(10)->Range(10, 10000);
 BENCHMARK(category)->RangeMultiplier(10)->Range(10, 10000);
+BENCHMARK(category_string)->RangeMultiplier(10)->Range(10, 10000);
+BENCHMARK(category_cstring)->RangeMultiplier(10)->Range(10, 10000);
+BENCHMARK(category_skewed)->RangeMultiplier(4)->Range(4, 256);
+BENCHMARK_TEMPLATE(category_string_runs, false)->Ranges({{10, 1000}, {1, 16}});
+BENCHMARK_TEMPLATE(category_string_runs, true)->Ranges({{10, 1000}, {1, 16}});
@@ -6,8 +6,10 @@
 
 #include <benchmark/benchmark.h>
 #include <boost/histogram/axis/regular.hpp>
+#include <boost/histogram/paged_unlimited_storage.hpp>
 #include <boost/histogram/storage_adaptor.hpp>
 #include <memory>
+#include <vector>
 #include "../test/throw_exception.hpp"
 #include "../test/utility_histogram.hpp"
 #include "generator.hpp"
@@ -30,6 +32,8 @@ using DStore = boost::histogram::unlimited_storage<>;
 using DStore = boost::histogram::adaptive_storage<>;
 #endif
 
+using PStore = boost::histogram::paged_unlimited_storage<>;
+
 using namespace boost::histogram;
 using reg = axis::regular<>;
 
@@ -38,6 +42,7 @@ static void fill_1d(benchmark::State& state) {
   auto h = make_s(Tag(), Storage(), reg(100, 0, 1));
   auto gen = generator<Distribution>();
   for (auto _ : state) benchmark::DoNotOptimize(h(gen()));
+  state.SetItemsProcessed(state.iterations());
 }
 
 template <class Distribution, class Tag, class Storage>
@@ -45,6 +50,7 @@ static void fill_2d(benchmark::State& state) {
   auto h = make_s(Tag(), Storage(), reg(100, 0, 1), reg(100, 0, 1));
   auto gen = generator<Distribution>();
   for (auto _ : state) benchmark::DoNotOptimize(h(gen(), gen()));
+  state.SetItemsProcessed(state.iterations());
 }
 
 template <class Distribution, class Tag, class Storage>
@@ -52,6 +58,7 @@ static void fill_3d(benchmark::State& state) {
   auto h = make_s(Tag(), Storage(), reg(100, 0, 1), reg(100, 0, 1), reg(100, 0, 1));
   auto gen = generator<Distribution>();
   for (auto _ : state) benchmark::DoNotOptimize(h(gen(), gen(), gen()));
+  state.SetItemsProcessed(state.iterations());
 }
 
 template <class Distribution, class Tag, class Storage>
@@ -61,6 +68,105 @@ static void fill_6d(benchmark::State& state) {
   auto gen = generator<Distribution>();
   for (auto _ : state)
     benchmark::DoNotOptimize(h(gen(), gen(), gen(), gen(), gen(), gen()));
+  state.SetItemsProcessed(state.iterations());
+}
+
+// batch filling, one column per axis
+template <class Distribution, unsigned N>
+std::vector<std::vector<double>> make_columns() {
+  constexpr std::size_t size = 1 << 15;
+  std::vector<std::vector<double>> columns(N);
+  auto gen = generator<Distribution, size>();
+  for (auto&& c : columns) {
+    c.resize(size);
+    for (auto&& x : c) x = gen();
+  }
+  return columns;
+}
+
+template <class Distribution, class Tag, class Storage>
+static void fill_n_1d(benchmark::State& state) {
+  auto h = make_s(Tag(), Storage(), reg(100, 0, 1));
+  const auto columns = make_columns<Distribution, 1>();
+  for (auto _ : state) h.fill(columns);
+  state.SetItemsProcessed(state.iterations() * columns[0].size());
+}
+
+template <class Distribution, class Tag, class Storage>
+static void fill_n_2d(benchmark::State& state) {
+  auto h = make_s(Tag(), Storage(), reg(100, 0, 1), reg(100, 0, 1));
+  const auto columns = make_columns<Distribution, 2>();
+  for (auto _ : state) h.fill(columns);
+  state.SetItemsProcessed(state.iterations() * columns[0].size());
+}
+
+template <class Distribution, class Tag, class Storage>
+static void fill_n_3d(benchmark::State& state) {
+  auto h = make_s(Tag(), Storage(), reg(100, 0, 1), reg(100, 0, 1), reg(100, 0, 1));
+  const auto columns = make_columns<Distribution, 3>();
+  for (auto _ : state) h.fill(columns);
+  state.SetItemsProcessed(state.iterations() * columns[0].size());
+}
+
+template <class Distribution, class Tag, class Storage>
+static void fill_n_6d(benchmark::State& state) {
+  auto h = make_s(Tag(), Storage(), reg(10, 0, 1), reg(10, 0, 1), reg(10, 0, 1),
+                  reg(10, 0, 1), reg(10, 0, 1), reg(10, 0, 1));
+  const auto columns = make_columns<Distribution, 6>();
+  for (auto _ : state) h.fill(columns);
+  state.SetItemsProcessed(state.iterations() * columns[0].size());
+}
+
+// stream of values which steadily extends the range of a growing axis
+template <class Tag, class Storage>
+static void fill_1d_growth(benchmark::State& state) {
+  using int_growth = axis::integer<int, use_default, axis::option::growth_t>;
+  for (auto _ : state) {
+    auto h = make_s(Tag(), Storage(), int_growth(0, 1));
+    for (int i = 0; i < 10000; ++i) h(i);
+    benchmark::DoNotOptimize(h);
+  }
+  state.SetItemsProcessed(state.iterations() * 10000);
+}
+
+// growth of the inner axis of a 3D histogram with about 10^6 cells relocates all cells
+template <class Tag, class Storage>
+static void fill_3d_growth(benchmark::State& state) {
+  using int_growth = axis::integer<int, use_default, axis::option::growth_t>;
+  for (auto _ : state) {
+    auto h = make_s(Tag(), Storage(), int_growth(0, 100), int_growth(0, 100),
+                    int_growth(0, 100));
+    for (int i = 1; i <= 10; ++i) h(-i, 0, 0);
+    benchmark::DoNotOptimize(h);
+  }
+  state.SetItemsProcessed(state.iterations() * 10);
+}
+
+// batch which drifts out of the range of growing axes
+template <class Tag, class Storage>
+static void fill_n_2d_growth(benchmark::State& state) {
+  using reg_growth =
+      axis::regular<double, use_default, use_default, axis::option::growth_t>;
+  std::vector<std::vector<double>> columns(2, std::vector<double>(1 << 15));
+  for (std::size_t i = 0; i < columns[0].size(); ++i)
+    columns[0][i] = columns[1][i] = 1e-3 * i;
+  for (auto _ : state) {
+    auto h = make_s(Tag(), Storage(), reg_growth(10, 0, 1), reg_growth(10, 0, 1));
+    h.fill(columns);
+    benchmark::DoNotOptimize(h);
+  }
+  state.SetItemsProcessed(state.iterations() * columns[0].size());
+}
+
+// few cells of a 3D histogram with 10^6 cells overflow 8 and then 16 bit counters
+template <class Tag, class Storage>
+static void fill_3d_hot_cells(benchmark::State& state) {
+  for (auto _ : state) {
+    auto h = make_s(Tag(), Storage(), reg(100, 0, 1), reg(100, 0, 1), reg(100, 0, 1));
+    for (int i = 0; i < 70000; ++i) h(0.5, 0.5, 0.5);
+    benchmark::DoNotOptimize(h);
+  }
+  state.SetItemsProcessed(state.iterations() * 70000);
 }
 
 BENCHMARK_TEMPLATE(fill_1d, uniform, static_tag, SStore);
@@ -73,8 +179,10 @@ BENCHMARK_TEMPLATE(fill_2d, uniform, dynamic_tag, SStore);
 BENCHMARK_TEMPLATE(fill_2d, uniform, dynamic_tag, DStore);
 BENCHMARK_TEMPLATE(fill_3d, uniform, static_tag, SStore);
 BENCHMARK_TEMPLATE(fill_3d, uniform, static_tag, DStore);
+BENCHMARK_TEMPLATE(fill_3d, uniform, static_tag, PStore);
 BENCHMARK_TEMPLATE(fill_3d, uniform, dynamic_tag, SStore);
 BENCHMARK_TEMPLATE(fill_3d, uniform, dynamic_tag, DStore);
+BENCHMARK_TEMPLATE(fill_3d, uniform, dynamic_tag, PStore);
 BENCHMARK_TEMPLATE(fill_6d, uniform, static_tag, SStore);
 BENCHMARK_TEMPLATE(fill_6d, uniform, static_tag, DStore);
 BENCHMARK_TEMPLATE(fill_6d, uniform, dynamic_tag, SStore);
@@ -96,3 +204,57 @@ BENCHMARK_TEMPLATE(fill_6d, normal, static_tag, SStore);
 BENCHMARK_TEMPLATE(fill_6d, normal, static_tag, DStore);
 BENCHMARK_TEMPLATE(fill_6d, normal, dynamic_tag, SStore);
 BENCHMARK_TEMPLATE(fill_6d, normal, dynamic_tag, DStore);
+
+BENCHMARK_TEMPLATE(fill_n_1d, uniform, static_tag, SStore);
+BENCHMARK_TEMPLATE(fill_n_1d, uniform, static_tag, DStore);
+BENCHMARK_TEMPLATE(fill_n_1d, uniform, dynamic_tag, SStore);
+BENCHMARK_TEMPLATE(fill_n_1d, uniform, dynamic_tag, DStore);
+BENCHMARK_TEMPLATE(fill_n_2d, uniform, static_tag, SStore);
+BENCHMARK_TEMPLATE(fill_n_2d, uniform, static_tag, DStore);
+BENCHMARK_TEMPLATE(fill_n_2d, uniform, dynamic_tag, SStore);
+BENCHMARK_TEMPLATE(fill_n_2d, uniform, dynamic_tag, DStore);
+BENCHMARK_TEMPLATE(fill_n_3d, uniform, static_tag, SStore);
+BENCHMARK_TEMPLATE(fill_n_3d, uniform, static_tag, DStore);
+BENCHMARK_TEMPLATE(fill_n_3d, uniform, static_tag, PStore);
+BENCHMARK_TEMPLATE(fill_n_3d, uniform, dynamic_tag, SStore);
+BENCHMARK_TEMPLATE(fill_n_3d, uniform, dynamic_tag, DStore);
+BENCHMARK_TEMPLATE(fill_n_3d, uniform, dynamic_tag, PStore);
+BENCHMARK_TEMPLATE(fill_n_6d, uniform, static_tag, SStore);
+BENCHMARK_TEMPLATE(fill_n_6d, uniform, static_tag, DStore);
+BENCHMARK_TEMPLATE(fill_n_6d, uniform, dynamic_tag, SStore);
+BENCHMARK_TEMPLATE(fill_n_6d, uniform, dynamic_tag, DStore);
+
+BENCHMARK_TEMPLATE(fill_n_1d, normal, static_tag, SStore);
+BENCHMARK_TEMPLATE(fill_n_1d, normal, static_tag, DStore);
+BENCHMARK_TEMPLATE(fill_n_1d, normal, dynamic_tag, SStore);
+BENCHMARK_TEMPLATE(fill_n_1d, normal, dynamic_tag, DStore);
+BENCHMARK_TEMPLATE(fill_n_2d, normal, static_tag, SStore);
+BENCHMARK_TEMPLATE(fill_n_2d, normal, static_tag, DStore);
+BENCHMARK_TEMPLATE(fill_n_2d, normal, dynamic_tag, SStore);
+BENCHMARK_TEMPLATE(fill_n_2d, normal, dynamic_tag, DStore);
+BENCHMARK_TEMPLATE(fill_n_3d, normal, static_tag, SStore);
+BENCHMARK_TEMPLATE(fill_n_3d, normal, static_tag, DStore);
+BENCHMARK_TEMPLATE(fill_n_3d, normal, dynamic_tag, SStore);
+BENCHMARK_TEMPLATE(fill_n_3d, normal, dynamic_tag, DStore);
+BENCHMARK_TEMPLATE(fill_n_6d, normal, static_tag, SStore);
+BENCHMARK_TEMPLATE(fill_n_6d, normal, static_tag, DStore);
+BENCHMARK_TEMPLATE(fill_n_6d, normal, dynamic_tag, SStore);
+BENCHMARK_TEMPLATE(fill_n_6d, normal, dynamic_tag, DStore);
+
+BENCHMARK_TEMPLATE(fill_n_2d_growth, static_tag, SStore);
+BENCHMARK_TEMPLATE(fill_n_2d_growth, static_tag, DStore);
+BENCHMARK_TEMPLATE(fill_n_2d_growth, dynamic_tag, SStore);
+BENCHMARK_TEMPLATE(fill_n_2d_growth, dynamic_tag, DStore);
+
+BENCHMARK_TEMPLATE(fill_1d_growth, static_tag, SStore);
+BENCHMARK_TEMPLATE(fill_1d_growth, static_tag, DStore);
+BENCHMARK_TEMPLATE(fill_1d_growth, dynamic_tag, SStore);
+BENCHMARK_TEMPLATE(fill_1d_growth, dynamic_tag, DStore);
+BENCHMARK_TEMPLATE(fill_3d_growth, static_tag, SStore);
+BENCHMARK_TEMPLATE(fill_3d_growth, static_tag, DStore);
+BENCHMARK_TEMPLATE(fill_3d_growth, dynamic_tag, SStore);
+BENCHMARK_TEMPLATE(fill_3d_growth, dynamic_tag, DStore);
+
+BENCHMARK_TEMPLATE(fill_3d_hot_cells, static_tag, SStore);
+BENCHMARK_TEMPLATE(fill_3d_hot_cells, static_tag, DStore);
+BENCHMARK_TEMPLATE(fill_3d_hot_cells, static_tag, PStore);
@@ -6,14 +6,20 @@
 
 #include <benchmark/benchmark.h>
 #include <boost/histogram/accumulators/thread_safe.hpp>
+#include <boost/histogram/axis/category.hpp>
 #include <boost/histogram/axis/regular.hpp>
+#include <boost/histogram/buffered_storage.hpp>
 #include <boost/histogram/histogram.hpp>
 #include <boost/histogram/make_histogram.hpp>
+#include <boost/histogram/sharded_storage.hpp>
+#include <boost/histogram/striped_storage.hpp>
+#include <boost/histogram/thread_pool.hpp>
 #include <chrono>
 #include <functional>
 #include <mutex>
 #include <numeric>
 #include <random>
+#include <string>
 #include <thread>
 #include <vector>
 #include "../test/throw_exception.hpp"
@@ -30,6 +36,9 @@ using namespace std::chrono_literals;
 
 using DS = dense_storage<unsigned>;
 using DSTS = dense_storage<accumulators::thread_safe<unsigned>>;
+using SDS = sharded_storage<DS>;
+using BDS = buffered_storage<DSTS>;
+using STS = striped_storage<unsigned>;
 
 static void NoThreads(benchmark::State& state) {
   std::default_random_engine gen(1);
@@ -65,6 +74,96 @@ static void AtomicStorage(benchmark::State& state) {
   }
 }
 
+static auto shist = make_histogram_with(SDS(), axis::regular<>());
+
+static void ShardedStorage(benchmark::State& state) {
+  init.lock();
+  if (state.thread_index == 0) {
+    const unsigned nbins = state.range(0);
+    shist = make_histogram_with(SDS(), axis::regular<>(nbins, 0, 1));
+  }
+  init.unlock();
+  std::default_random_engine gen(state.thread_index);
+  std::uniform_real_distribution<> dis(0, 1);
+  for (auto _ : state) {
+    // simulate some work
+    for (volatile unsigned n = 0; n < state.range(1); ++n)
+      ;
+    shist(dis(gen));
+  }
+}
+
+static auto bhist = make_histogram_with(BDS(), axis::regular<>());
+
+static void BufferedStorage(benchmark::State& state) {
+  init.lock();
+  if (state.thread_index == 0) {
+    const unsigned nbins = state.range(0);
+    bhist = make_histogram_with(BDS(), axis::regular<>(nbins, 0, 1));
+  }
+  init.unlock();
+  std::default_random_engine gen(state.thread_index);
+  std::uniform_real_distribution<> dis(0, 1);
+  for (auto _ : state) {
+    // simulate some work
+    for (volatile unsigned n = 0; n < state.range(1); ++n)
+      ;
+    bhist(dis(gen));
+  }
+}
+
+static auto thist = make_histogram_with(STS(), axis::regular<>());
+
+static void StripedStorage(benchmark::State& state) {
+  init.lock();
+  if (state.thread_index == 0) {
+    const unsigned nbins = state.range(0);
+    thist = make_histogram_with(STS(), axis::regular<>(nbins, 0, 1));
+  }
+  init.unlock();
+  std::default_random_engine gen(state.thread_index);
+  std::uniform_real_distribution<> dis(0, 1);
+  for (auto _ : state) {
+    // simulate some work
+    for (volatile unsigned n = 0; n < state.range(1); ++n)
+      ;
+    thist(dis(gen));
+  }
+}
+
+// growing category axis, which only grows during the first few fills
+using GC = axis::category<std::string, use_default, axis::option::growth_t>;
+static auto ghist = make_histogram_with(DSTS(), GC());
+
+static void GrowingCategory(benchmark::State& state) {
+  init.lock();
+  if (state.thread_index == 0) ghist = make_histogram_with(DSTS(), GC());
+  init.unlock();
+  std::vector<std::string> labels;
+  for (int i = 0; i < state.range(0); ++i) labels.push_back("label" + std::to_string(i));
+  std::default_random_engine gen(state.thread_index);
+  std::uniform_int_distribution<> dis(0, state.range(0) - 1);
+  for (auto _ : state) {
+    // simulate some work
+    for (volatile unsigned n = 0; n < state.range(1); ++n)
+      ;
+    ghist(labels[dis(gen)]);
+  }
+}
+
+// batch of values filled by a thread pool
+static void ParallelBatch(benchmark::State& state) {
+  std::default_random_engine gen(1);
+  std::uniform_real_distribution<> dis(0, 1);
+  const unsigned nbins = state.range(0);
+  std::vector<double> x(1 << 20);
+  for (auto&& xi : x) xi = dis(gen);
+  thread_pool pool(state.range(1));
+  auto hist = make_histogram_with(DS(), axis::regular<>(nbins, 0, 1));
+  for (auto _ : state) hist.fill(pool, x);
+  state.SetItemsProcessed(state.iterations() * x.size());
+}
+
 BENCHMARK(NoThreads)
     ->UseRealTime()
 
@@ -147,3 +246,154 @@ BENCHMARK(AtomicStorage)
     ->Args({1 << 18, 100})
 
     ;
+
+BENCHMARK(ShardedStorage)
+    ->UseRealTime()
+    ->Threads(1)
+    ->Threads(2)
+    ->Threads(4)
+
+    ->Args({1 << 4, 0})
+    ->Args({1 << 6, 0})
+    ->Args({1 << 8, 0})
+    ->Args({1 << 10, 0})
+    ->Args({1 << 14, 0})
+    ->Args({1 << 18, 0})
+
+    ->Args({1 << 4, 5})
+    ->Args({1 << 6, 5})
+    ->Args({1 << 8, 5})
+    ->Args({1 << 10, 5})
+    ->Args({1 << 14, 5})
+    ->Args({1 << 18, 5})
+
+    ->Args({1 << 4, 10})
+    ->Args({1 << 6, 10})
+    ->Args({1 << 8, 10})
+    ->Args({1 << 10, 10})
+    ->Args({1 << 14, 10})
+    ->Args({1 << 18, 10})
+
+    ->Args({1 << 4, 50})
+    ->Args({1 << 6, 50})
+    ->Args({1 << 8, 50})
+    ->Args({1 << 10, 50})
+    ->Args({1 << 14, 50})
+    ->Args({1 << 18, 50})
+
+    ->Args({1 << 4, 100})
+    ->Args({1 << 6, 100})
+    ->Args({1 << 8, 100})
+    ->Args({1 << 10, 100})
+    ->Args({1 << 14, 100})
+    ->Args({1 << 18, 100})
+
+    ;
+
+BENCHMARK(BufferedStorage)
+    ->UseRealTime()
+    ->Threads(1)
+    ->Threads(2)
+    ->Threads(4)
+
+    ->Args({1 << 4, 0})
+    ->Args({1 << 6, 0})
+    ->Args({1 << 8, 0})
+    ->Args({1 << 10, 0})
+    ->Args({1 << 14, 0})
+    ->Args({1 << 18, 0})
+
+    ->Args({1 << 4, 5})
+    ->Args({1 << 6, 5})
+    ->Args({1 << 8, 5})
+    ->Args({1 << 10, 5})
+    ->Args({1 << 14, 5})
+    ->Args({1 << 18, 5})
+
+    ->Args({1 << 4, 10})
+    ->Args({1 << 6, 10})
+    ->Args({1 << 8, 10})
+    ->Args({1 << 10, 10})
+    ->Args({1 << 14, 10})
+    ->Args({1 << 18, 10})
+
+    ->Args({1 << 4, 50})
+    ->Args({1 << 6, 50})
+    ->Args({1 << 8, 50})
+    ->Args({1 << 10, 50})
+    ->Args({1 << 14, 50})
+    ->Args({1 << 18, 50})
+
+    ->Args({1 << 4, 100})
+    ->Args({1 << 6, 100})
+    ->Args({1 << 8, 100})
+    ->Args({1 << 10, 100})
+    ->Args({1 << 14, 100})
+    ->Args({1 << 18, 100})
+
+    ;
+
+BENCHMARK(StripedStorage)
+    ->UseRealTime()
+    ->Threads(1)
+    ->Threads(2)
+    ->Threads(4)
+
+    ->Args({1 << 4, 0})
+    ->Args({1 << 6, 0})
+    ->Args({1 << 8, 0})
+    ->Args({1 << 10, 0})
+    ->Args({1 << 14, 0})
+    ->Args({1 << 18, 0})
+
+    ->Args({1 << 4, 5})
+    ->Args({1 << 6, 5})
+    ->Args({1 << 8, 5})
+    ->Args({1 << 10, 5})
+    ->Args({1 << 14, 5})
+    ->Args({1 << 18, 5})
+
+    ->Args({1 << 4, 10})
+    ->Args({1 << 6, 10})
+    ->Args({1 << 8, 10})
+    ->Args({1 << 10, 10})
+    ->Args({1 << 14, 10})
+    ->Args({1 << 18, 10})
+
+    ->Args({1 << 4, 50})
+    ->Args({1 << 6, 50})
+    ->Args({1 << 8, 50})
+    ->Args({1 << 10, 50})
+    ->Args({1 << 14, 50})
+    ->Args({1 << 18, 50})
+
+    ->Args({1 << 4, 100})
+    ->Args({1 << 6, 100})
+    ->Args({1 << 8, 100})
+    ->Args({1 << 10, 100})
+    ->Args({1 << 14, 100})
+    ->Args({1 << 18, 100})
+
+    ;
+
+BENCHMARK(GrowingCategory)
+    ->UseRealTime()
+    ->Threads(1)
+    ->Threads(2)
+    ->Threads(4)
+    ->Args({1 << 4, 0})
+    ->Args({1 << 8, 0})
+    ->Args({1 << 4, 50})
+    ->Args({1 << 8, 50});
+
+BENCHMARK(ParallelBatch)
+    ->UseRealTime()
+    ->Args({1 << 4, 1})
+    ->Args({1 << 4, 2})
+    ->Args({1 << 4, 4})
+    ->Args({1 << 10, 1})
+    ->Args({1 << 10, 2})
+    ->Args({1 << 10, 4})
+    ->Args({1 << 18, 1})
+    ->Args({1 << 18, 2})
+    ->Args({1 << 18, 4});
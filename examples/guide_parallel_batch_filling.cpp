@@ -0,0 +1,39 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+//[ guide_parallel_batch_filling
+
+#include <boost/histogram.hpp>
+#include <boost/histogram/algorithm/sum.hpp>
+#include <cassert>
+#include <vector>
+
+int main() {
+  using namespace boost::histogram;
+
+  auto h = make_histogram(axis::regular<>(10, 0.0, 1.0), axis::integer<>(0, 5));
+
+  // columns of values, one for each axis
+  std::vector<std::vector<double>> xy(2);
+  for (unsigned i = 0; i < 100000; ++i) {
+    xy[0].push_back((i % 97) / 97.0);
+    xy[1].push_back(i % 5);
+  }
+
+  /*
+    The thread pool runs the parallel loops of histogram::fill. It can be reused for
+    many fills. Any other type which provides the methods size() and run(n, f) can be
+    used instead, for example, an adaptor to a thread pool of the application.
+  */
+  thread_pool pool(4);
+
+  // Each thread fills a part of the batch, the results are added afterwards.
+  h.fill(pool, xy);
+
+  assert(algorithm::sum(h) == 100000);
+}
+
+//]
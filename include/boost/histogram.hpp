@@ -32,12 +32,17 @@
 #include <boost/histogram/algorithm/reduce.hpp>
 #include <boost/histogram/algorithm/sum.hpp>
 #include <boost/histogram/axis.hpp>
+#include <boost/histogram/buffered_storage.hpp>
 #include <boost/histogram/histogram.hpp>
 #include <boost/histogram/indexed.hpp>
 #include <boost/histogram/literals.hpp>
 #include <boost/histogram/make_histogram.hpp>
 #include <boost/histogram/make_profile.hpp>
+#include <boost/histogram/paged_unlimited_storage.hpp>
+#include <boost/histogram/sharded_storage.hpp>
 #include <boost/histogram/storage_adaptor.hpp>
+#include <boost/histogram/striped_storage.hpp>
+#include <boost/histogram/thread_pool.hpp>
 #include <boost/histogram/unlimited_storage.hpp>
 
 #endif
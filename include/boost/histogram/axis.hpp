@@ -9,7 +9,10 @@
 
 #include <boost/histogram/axis/category.hpp>
 #include <boost/histogram/axis/integer.hpp>
+#include <boost/histogram/axis/integer_regular.hpp>
+#include <boost/histogram/axis/log_linear.hpp>
 #include <boost/histogram/axis/regular.hpp>
+#include <boost/histogram/axis/static_regular.hpp>
 #include <boost/histogram/axis/variable.hpp>
 #include <boost/histogram/axis/variant.hpp>
 
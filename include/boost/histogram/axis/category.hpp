@@ -12,16 +12,46 @@
 #include <boost/histogram/axis/option.hpp>
 #include <boost/histogram/detail/compressed_pair.hpp>
 #include <boost/histogram/detail/detect.hpp>
+#include <boost/histogram/detail/hash_index.hpp>
+#include <boost/histogram/detail/perfect_hash_index.hpp>
+#include <boost/histogram/detail/probe_order.hpp>
 #include <boost/histogram/detail/relaxed_equal.hpp>
 #include <boost/histogram/detail/replace_default.hpp>
 #include <boost/histogram/fwd.hpp>
 #include <boost/throw_exception.hpp>
+#include <cstddef>
 #include <stdexcept>
 #include <string>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
+/** Minimum number of categories for which a growing category axis uses a hash index.
+ *
+ * Below this size, a linear search of the values is faster than a hash lookup.
+ */
+#ifndef BOOST_HISTOGRAM_DETAIL_CATEGORY_HASH_THRESHOLD
+#define BOOST_HISTOGRAM_DETAIL_CATEGORY_HASH_THRESHOLD 16
+#endif
+
+/** Minimum number of categories for which a category axis which cannot grow uses a
+ * perfect hash.
+ *
+ * A lookup in a perfect hash is faster than in a hash table, so it pays off earlier.
+ */
+#ifndef BOOST_HISTOGRAM_DETAIL_CATEGORY_PERFECT_HASH_THRESHOLD
+#define BOOST_HISTOGRAM_DETAIL_CATEGORY_PERFECT_HASH_THRESHOLD 8
+#endif
+
+/** Minimum number of categories for which a category axis without hash index adapts
+ * the order of its linear search to the frequency of the values.
+ *
+ * Below this size, a plain search in the order of the values is faster.
+ */
+#ifndef BOOST_HISTOGRAM_DETAIL_CATEGORY_PROBE_ORDER_THRESHOLD
+#define BOOST_HISTOGRAM_DETAIL_CATEGORY_PROBE_ORDER_THRESHOLD 128
+#endif
+
 namespace boost {
 namespace histogram {
 namespace axis {
@@ -31,8 +61,18 @@ namespace axis {
 
   The axis maps a set of values to bins, following the order of arguments in the
   constructor. The optional overflow bin for this axis counts input values that
-  are not part of the set. Binning has O(N) complexity, but with a very small
-  factor. For small N (the typical use case) it beats other kinds of lookup.
+  are not part of the set. For small N (the typical use case), binning uses a linear
+  search with O(N) complexity, but with a very small factor, which beats other kinds of
+  lookup. For large N, if the value type is supported by std::hash, the axis
+  additionally keeps a hash index of the values, so that binning has O(1) complexity.
+  If the axis can grow, this is an open-addressing hash table which is updated when the
+  axis grows. Otherwise, the set of values is fixed after construction and the axis
+  builds a minimal perfect hash, which finds a value with one hash computation and one
+  comparison. Integer values which span a small range are looked up in a table instead,
+  for any N. The hash index does not affect the bin order, comparison, or serialization.
+  Values without a hash index and many categories are searched in an internal order,
+  which adapts to the frequency of the values, so that frequent values are found after
+  few comparisons.
 
   @tparam Value input value type, must be equal-comparable.
   @tparam MetaData type to store meta data.
@@ -56,12 +96,25 @@ class category : public iterator_mixin<category<Value, MetaData, Options, Alloca
                 "growing category axis cannot have overflow");
   using allocator_type = Allocator;
   using vector_type = std::vector<value_type, allocator_type>;
+  // values of an axis which cannot grow are fixed after construction
+  using hash_index_type = std::conditional_t<
+      detail::is_hashable_with<value_type>::value,
+      std::conditional_t<options_type::test(option::growth),
+                         detail::hash_index<allocator_type>,
+                         detail::perfect_hash_index<allocator_type>>,
+      detail::no_hash_index<allocator_type>>;
+  template <class U>
+  using is_transparent = detail::is_transparent_key<value_type, U>;
 
 public:
-  explicit category(allocator_type alloc = {}) : vec_meta_(vector_type(alloc)) {}
+  explicit category(allocator_type alloc = {})
+      : vec_meta_(vector_type(alloc)), hash_(alloc), order_(alloc) {}
   category(const category&) = default;
   category& operator=(const category&) = default;
-  category(category&& o) noexcept : vec_meta_(std::move(o.vec_meta_)) {
+  category(category&& o) noexcept
+      : vec_meta_(std::move(o.vec_meta_)),
+        hash_(std::move(o.hash_)),
+        order_(std::move(o.order_)) {
     // std::string explicitly guarantees nothrow only in C++17
     static_assert(std::is_same<metadata_type, std::string>::value ||
                       std::is_nothrow_move_constructible<metadata_type>::value,
@@ -73,6 +126,8 @@ public:
                       std::is_nothrow_move_assignable<metadata_type>::value,
                   "");
     vec_meta_ = std::move(o.vec_meta_);
+    hash_ = std::move(o.hash_);
+    order_ = std::move(o.order_);
     return *this;
   }
 
@@ -85,8 +140,11 @@ public:
    */
   template <class It, class = detail::requires_iterator<It>>
   category(It begin, It end, metadata_type meta = {}, allocator_type alloc = {})
-      : vec_meta_(vector_type(begin, end, alloc), std::move(meta)) {
+      : vec_meta_(vector_type(begin, end, alloc), std::move(meta)),
+        hash_(alloc),
+        order_(alloc) {
     if (size() == 0) BOOST_THROW_EXCEPTION(std::invalid_argument("bins > 0 required"));
+    rebuild_index();
   }
 
   /** Construct axis from iterable sequence of unique values.
@@ -112,10 +170,48 @@ public:
       : category(list.begin(), list.end(), std::move(meta), std::move(alloc)) {}
 
   /// Return index for value argument.
-  index_type index(const value_type& x) const noexcept {
-    const auto beg = vec_meta_.first().begin();
-    const auto end = vec_meta_.first().end();
-    return static_cast<index_type>(std::distance(beg, std::find(beg, end, x)));
+  index_type index(const value_type& x) const noexcept { return find_key(x); }
+
+  /** Return index for value argument, comparing first with the value at the hint.
+   *
+   * This is fast if the hint is the index of an equal value, for example the previous
+   * value of a sequence with many repetitions. The result does not depend on the hint.
+   *
+   * \param x     input value.
+   * \param hint  any index, usually the result of a previous call.
+   */
+  index_type index_near(const value_type& x, index_type hint) const noexcept {
+    const auto& vec = vec_meta_.first();
+    if (0 <= hint && hint < size() && vec[hint] == x) return hint;
+    return find_key(x);
+  }
+
+  /// Compute indices for n values (used by histogram::fill, not for users).
+  void index_n(const value_type* x, index_type* out, std::size_t n) const noexcept {
+    // If the first values are mostly repeated, the remaining values are compared first
+    // with the value at the index of the previous value.
+    const auto m = std::min(n, repeat_sample);
+    std::size_t repeated = 0;
+    for (std::size_t i = 0; i < m; ++i) {
+      out[i] = index(x[i]);
+      repeated += i > 0 && out[i] == out[i - 1];
+    }
+    if (4 * repeated < 3 * m) {
+      for (std::size_t i = m; i < n; ++i) out[i] = index(x[i]);
+      return;
+    }
+    for (std::size_t i = m; i < n; ++i) out[i] = index_near(x[i], out[i - 1]);
+  }
+
+  /** Return index for an argument which is equal-comparable to the values.
+   *
+   * Unlike index(), the argument is not converted to the value type. For example, a
+   * category<std::string> can be searched with a `const char*` or `std::string_view`
+   * without allocating a temporary string.
+   */
+  template <class U, class = std::enable_if_t<is_transparent<U>::value>>
+  index_type find(const U& x) const noexcept {
+    return find_key(detail::lookup_key<value_type>::make(x));
   }
 
   /// Returns index and shift (if axis has grown) for the passed argument.
@@ -123,6 +219,23 @@ public:
     const auto i = index(x);
     if (i < size()) return std::make_pair(i, 0);
     vec_meta_.first().emplace_back(x);
+    update_index();
+    return std::make_pair(i, -1);
+  }
+
+  /** Returns index and shift (if axis has grown) for an argument which is
+   * equal-comparable to the values.
+   *
+   * Like update(), but the argument is only converted to the value type if the axis
+   * grows.
+   */
+  template <class U, class = std::enable_if_t<is_transparent<U>::value>>
+  auto emplace(const U& x) {
+    const auto k = detail::lookup_key<value_type>::make(x);
+    const auto i = find_key(k);
+    if (i < size()) return std::make_pair(i, 0);
+    vec_meta_.first().emplace_back(k.data, k.size);
+    update_index();
     return std::make_pair(i, -1);
   }
 
@@ -167,12 +280,56 @@ public:
   void serialize(Archive&, unsigned);
 
 private:
+  template <class Key>
+  index_type find_key(const Key& k) const noexcept {
+    const auto& vec = vec_meta_.first();
+    if (!hash_.empty()) return hash_.find(vec, k);
+    if (!order_.empty()) return order_.find(vec, k);
+    return static_cast<index_type>(
+        std::distance(vec.begin(), std::find(vec.begin(), vec.end(), k)));
+  }
+
+  // number of values from which index_n decides whether to compare with the previous
+  // value first
+  static constexpr std::size_t repeat_sample = 32;
+
+  static constexpr std::size_t hash_threshold =
+      options_type::test(option::growth)
+          ? BOOST_HISTOGRAM_DETAIL_CATEGORY_HASH_THRESHOLD
+          : BOOST_HISTOGRAM_DETAIL_CATEGORY_PERFECT_HASH_THRESHOLD;
+
+  // must be called after a value was appended
+  void update_index() {
+    hash_.push_back(vec_meta_.first(), hash_threshold);
+    if (use_order())
+      order_.push_back(size());
+    else
+      order_.reset(0);
+  }
+
+  void rebuild_index() {
+    hash_.rebuild(vec_meta_.first(), hash_threshold);
+    order_.reset(use_order() ? size() : 0);
+  }
+
+  bool use_order() const noexcept {
+    return hash_.empty() &&
+           static_cast<std::size_t>(size()) >=
+               BOOST_HISTOGRAM_DETAIL_CATEGORY_PROBE_ORDER_THRESHOLD;
+  }
+
   detail::compressed_pair<vector_type, metadata_type> vec_meta_;
+  hash_index_type hash_;
+  // order of the linear search, if there is no hash index
+  detail::probe_order<allocator_type> order_;
 
   template <class V, class M, class O, class A>
   friend class category;
 };
 
+template <class Value, class MetaData, class Options, class Allocator>
+constexpr std::size_t category<Value, MetaData, Options, Allocator>::repeat_sample;
+
 #if __cpp_deduction_guides >= 201606
 
 template <class T>
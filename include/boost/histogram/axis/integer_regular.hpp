@@ -0,0 +1,251 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_AXIS_INTEGER_REGULAR_HPP
+#define BOOST_HISTOGRAM_AXIS_INTEGER_REGULAR_HPP
+
+#include <boost/assert.hpp>
+#include <boost/histogram/axis/interval_view.hpp>
+#include <boost/histogram/axis/iterator.hpp>
+#include <boost/histogram/axis/option.hpp>
+#include <boost/histogram/axis/regular.hpp>
+#include <boost/histogram/detail/chrono.hpp>
+#include <boost/histogram/detail/compressed_pair.hpp>
+#include <boost/histogram/detail/fast_divide.hpp>
+#include <boost/histogram/detail/limits.hpp>
+#include <boost/histogram/detail/relaxed_equal.hpp>
+#include <boost/histogram/detail/replace_default.hpp>
+#include <boost/histogram/fwd.hpp>
+#include <boost/throw_exception.hpp>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace boost {
+namespace histogram {
+namespace axis {
+
+/**
+  Axis for equidistant intervals of integer values.
+
+  Like a regular axis, but for integral input values and bins with an integral width.
+  Binning is a O(1) operation, which is exact for all values and needs no conversion to
+  floating point. The bin is computed with integer arithmetic: the distance of the value
+  to the start of the axis is divided by the width with a multiplication and shifts,
+  which is a single shift if the width is a power of two.
+
+  The axis also accepts std::chrono::duration and std::chrono::time_point values with an
+  integral representation, which are binned on their tick count. Bin edges are returned
+  in the value type, and the step may be given as a duration, which must be a multiple
+  of the tick period.
+
+  @tparam Value input value type, integral or std::chrono type with integral ticks.
+  @tparam MetaData type to store meta data.
+  @tparam Options see boost::histogram::axis::option (no circular or growth).
+ */
+template <class Value, class MetaData, class Options>
+class integer_regular
+    : public iterator_mixin<integer_regular<Value, MetaData, Options>> {
+  static_assert(std::is_integral<detail::tick_type<Value>>::value,
+                "integer_regular axis requires integral type");
+
+  using value_type = Value;
+  using tick_type = detail::tick_type<value_type>;
+  using metadata_type = detail::replace_default<MetaData, std::string>;
+  using options_type =
+      detail::replace_default<Options, decltype(option::underflow | option::overflow)>;
+
+  static_assert(!options_type::test(option::circular) &&
+                    !options_type::test(option::growth),
+                "integer_regular axis cannot be circular or growing");
+
+public:
+  constexpr integer_regular() = default;
+  integer_regular(const integer_regular&) = default;
+  integer_regular& operator=(const integer_regular&) = default;
+  integer_regular(integer_regular&& o) noexcept
+      : size_meta_(std::move(o.size_meta_))
+      , min_(o.min_)
+      , span_(o.span_)
+      , div_(o.div_) {
+    // std::string explicitly guarantees nothrow only in C++17
+    static_assert(std::is_same<metadata_type, std::string>::value ||
+                      std::is_nothrow_move_constructible<metadata_type>::value,
+                  "");
+  }
+  integer_regular& operator=(integer_regular&& o) noexcept {
+    // std::string explicitly guarantees nothrow only in C++17
+    static_assert(std::is_same<metadata_type, std::string>::value ||
+                      std::is_nothrow_move_assignable<metadata_type>::value,
+                  "");
+    size_meta_ = std::move(o.size_meta_);
+    min_ = o.min_;
+    span_ = o.span_;
+    div_ = o.div_;
+    return *this;
+  }
+
+  /** Construct n bins over integer range [start, stop).
+   *
+   * @param n        number of bins, must divide stop - start.
+   * @param start    low edge of first bin.
+   * @param stop     high edge of last bin.
+   * @param meta     description of the axis (optional).
+   */
+  integer_regular(unsigned n, value_type start, value_type stop, metadata_type meta = {})
+      : size_meta_(0, std::move(meta)), min_(detail::ticks(start)) {
+    if (!(start < stop))
+      BOOST_THROW_EXCEPTION(std::invalid_argument("start < stop required"));
+    if (n == 0) BOOST_THROW_EXCEPTION(std::invalid_argument("bins > 0 required"));
+    const auto span = distance(min_, detail::ticks(stop));
+    if (span % n != 0)
+      BOOST_THROW_EXCEPTION(
+          std::invalid_argument("stop - start must be a multiple of bins"));
+    init(n, span / n);
+  }
+
+  /** Construct bins with the given step size over integer range [start, stop).
+   *
+   * @param step    width of a single bin, must be integral or a duration.
+   * @param start   low edge of first bin.
+   * @param stop    upper limit of high edge of last bin (see below).
+   * @param meta    description of the axis (optional).
+   *
+   * The axis computes the number of bins as n = (stop - start) / step, rounded down.
+   * This means that stop is an upper limit to the actual value (start + n * step).
+   */
+  template <class T>
+  integer_regular(const step_type<T>& step, value_type start, value_type stop,
+                  metadata_type meta = {})
+      : size_meta_(0, std::move(meta)), min_(detail::ticks(start)) {
+    const auto w = step_width(step.value);
+    if (w == 0)
+      BOOST_THROW_EXCEPTION(std::invalid_argument("integral step > 0 required"));
+    if (!(start < stop))
+      BOOST_THROW_EXCEPTION(std::invalid_argument("start < stop required"));
+    init(distance(min_, detail::ticks(stop)) / w, w);
+  }
+
+  /// Constructor used by algorithm::reduce to shrink and rebin (not for users).
+  integer_regular(const integer_regular& src, index_type begin, index_type end,
+                  unsigned merge)
+      : size_meta_(0, src.metadata()), min_(detail::ticks(src.value(begin))) {
+    BOOST_ASSERT((end - begin) % merge == 0);
+    init(static_cast<std::uint64_t>((end - begin) / merge), src.width() * merge);
+  }
+
+  /// Return index for value argument.
+  index_type index(value_type x) const noexcept {
+    // Runs in hot loop, please measure impact of changes
+    const auto t = detail::ticks(x);
+    if (t < min_) return -1;
+    const auto d = distance(min_, t);
+    return d < span_ ? static_cast<index_type>(div_(d)) : size();
+  }
+
+  /// Return value for fractional index argument.
+  value_type value(real_index_type i) const noexcept {
+    if (i < 0) return detail::from_ticks<value_type>(detail::lowest<tick_type>());
+    if (i > size()) return detail::from_ticks<value_type>(detail::highest<tick_type>());
+    // edges are computed exactly, modulo 2^64 to avoid overflow of signed types
+    const auto k = std::floor(i);
+    const auto a =
+        static_cast<std::uint64_t>(min_) + static_cast<std::uint64_t>(k) * width();
+    return detail::from_ticks<value_type>(
+        static_cast<tick_type>(a + static_cast<std::uint64_t>((i - k) * width())));
+  }
+
+  /// Return bin for index argument.
+  decltype(auto) bin(index_type idx) const noexcept {
+    return interval_view<integer_regular>(*this, idx);
+  }
+
+  /// Returns the number of bins, without over- or underflow.
+  index_type size() const noexcept { return size_meta_.first(); }
+  /// Returns the width of the bins in ticks.
+  std::uint64_t width() const noexcept { return div_.divisor(); }
+  /// Returns the options.
+  static constexpr unsigned options() noexcept { return options_type::value; }
+  /// Returns reference to metadata.
+  metadata_type& metadata() noexcept { return size_meta_.second(); }
+  /// Returns reference to const metadata.
+  const metadata_type& metadata() const noexcept { return size_meta_.second(); }
+
+  template <class V, class M, class O>
+  bool operator==(const integer_regular<V, M, O>& o) const noexcept {
+    return size() == o.size() && detail::relaxed_equal(metadata(), o.metadata()) &&
+           min_ == o.min_ && width() == o.width();
+  }
+
+  template <class V, class M, class O>
+  bool operator!=(const integer_regular<V, M, O>& o) const noexcept {
+    return !operator==(o);
+  }
+
+  template <class Archive>
+  void serialize(Archive&, unsigned);
+
+private:
+  // distance of a and b >= a, computed modulo 2^64
+  static std::uint64_t distance(tick_type a, tick_type b) noexcept {
+    return static_cast<std::uint64_t>(b) - static_cast<std::uint64_t>(a);
+  }
+
+  // step in ticks, zero if it is not a positive integral number of ticks
+  template <class T>
+  static std::uint64_t step_width(const T& s) noexcept {
+    const auto w = s > 0 ? static_cast<std::uint64_t>(s) : 0;
+    return static_cast<T>(w) == s ? w : 0;
+  }
+
+  template <class R, class P>
+  static std::uint64_t step_width(const std::chrono::duration<R, P>& s) noexcept {
+    using duration = typename detail::tick_traits<value_type>::duration;
+    const auto d = std::chrono::duration_cast<duration>(s);
+    return d == s ? step_width(d.count()) : 0;
+  }
+
+  void init(std::uint64_t n, std::uint64_t width) {
+    if (n == 0) BOOST_THROW_EXCEPTION(std::invalid_argument("bins > 0 required"));
+    if (n > static_cast<std::uint64_t>(std::numeric_limits<index_type>::max() - 1))
+      BOOST_THROW_EXCEPTION(std::invalid_argument("too many bins"));
+    size_meta_.first() = static_cast<index_type>(n);
+    span_ = n * width;
+    div_ = detail::fast_divider(width, span_ - 1);
+  }
+
+  detail::compressed_pair<index_type, metadata_type> size_meta_{0};
+  tick_type min_{0};
+  std::uint64_t span_ = 0;
+  detail::fast_divider div_;
+
+  template <class V, class M, class O>
+  friend class integer_regular;
+};
+
+#if __cpp_deduction_guides >= 201606
+
+template <class T>
+integer_regular(unsigned, T, T)->integer_regular<T>;
+
+template <class T>
+integer_regular(unsigned, T, T, const char*)->integer_regular<T>;
+
+template <class T, class M>
+integer_regular(unsigned, T, T, M)->integer_regular<T, M>;
+
+#endif
+
+} // namespace axis
+} // namespace histogram
+} // namespace boost
+
+#endif
@@ -0,0 +1,280 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_AXIS_LOG_LINEAR_HPP
+#define BOOST_HISTOGRAM_AXIS_LOG_LINEAR_HPP
+
+#include <boost/histogram/axis/interval_view.hpp>
+#include <boost/histogram/axis/iterator.hpp>
+#include <boost/histogram/axis/option.hpp>
+#include <boost/histogram/detail/chrono.hpp>
+#include <boost/histogram/detail/compressed_pair.hpp>
+#include <boost/histogram/detail/fast_divide.hpp>
+#include <boost/histogram/detail/limits.hpp>
+#include <boost/histogram/detail/relaxed_equal.hpp>
+#include <boost/histogram/detail/replace_default.hpp>
+#include <boost/histogram/detail/safe_comparison.hpp>
+#include <boost/histogram/fwd.hpp>
+#include <boost/throw_exception.hpp>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace boost {
+namespace histogram {
+namespace detail {
+
+/*
+  Bin keys of a log-linear axis. Each power of two is divided into 2^bits bins of equal
+  width, and the key counts the bins from zero. Keys are monotonic in the value.
+
+  For floating point values, the key consists of the exponent and the highest bits of
+  the mantissa of the IEEE representation of a positive value. For integers, values
+  below 2^bits have one bin per value, and the bin of larger values is found from the
+  position of their highest set bit.
+*/
+template <class T, bool = std::is_floating_point<T>::value>
+struct log_linear_key {
+  using bits_type = std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>;
+  static constexpr unsigned mantissa_bits = std::numeric_limits<T>::digits - 1;
+  static constexpr unsigned max_bits = mantissa_bits;
+
+  static_assert(std::numeric_limits<T>::is_iec559 && sizeof(T) == sizeof(bits_type),
+                "log_linear axis requires IEEE float or double");
+
+  static std::uint64_t key(T x, unsigned bits) noexcept {
+    bits_type u;
+    std::memcpy(&u, &x, sizeof(T));
+    // clear the sign of -0.0
+    u &= ~(bits_type{1} << (sizeof(T) * 8 - 1));
+    return u >> (mantissa_bits - bits);
+  }
+
+  static T edge(std::uint64_t k, unsigned bits) noexcept {
+    const auto u = static_cast<bits_type>(k << (mantissa_bits - bits));
+    T x;
+    std::memcpy(&x, &u, sizeof(T));
+    return x;
+  }
+};
+
+template <class T>
+struct log_linear_key<T, false> {
+  static constexpr unsigned max_bits =
+      std::numeric_limits<std::make_unsigned_t<T>>::digits - 1;
+
+  static std::uint64_t key(T x, unsigned bits) noexcept {
+    const auto u = static_cast<std::uint64_t>(x);
+    const auto e = highest_bit(u | 1);
+    const auto s = e > bits ? e - bits : 0;
+    return (std::uint64_t{s} << bits) + (u >> s);
+  }
+
+  static T edge(std::uint64_t k, unsigned bits) noexcept {
+    const auto t = k >> bits;
+    const auto r = k & ((std::uint64_t{1} << bits) - 1);
+    return static_cast<T>(t == 0 ? r : ((std::uint64_t{1} << bits) + r) << (t - 1));
+  }
+};
+
+} // namespace detail
+
+namespace axis {
+
+/**
+  Axis for positive values with log-linear bins, like those of HdrHistogram.
+
+  Each power of two is divided into 2^bits bins of equal width, so the relative width of
+  the bins is between 2^-bits and 2^(1-bits). Integer axes have bins of unit width for
+  values below 2^bits. The bins are computed like those of a regular axis with a log
+  transform, but finding the bin is a O(1) operation without transcendental functions:
+  it uses the exponent and the highest bits of the mantissa of floating point values,
+  and the position of the highest set bit of integer values.
+
+  For floating point values, the axis must start at a positive normal number, so that
+  zero, negative, and subnormal values below the axis fall into the underflow bin.
+  Integer axes may start at zero, then zero falls into the first bin. Values above the
+  axis and NaN fall into the overflow bin.
+
+  The axis also accepts std::chrono::duration and std::chrono::time_point values, which
+  are binned on their tick count. Bin edges are returned in the value type.
+
+  @tparam Value input value type, floating point, integral, or std::chrono type.
+  @tparam MetaData type to store meta data.
+  @tparam Options see boost::histogram::axis::option (no circular or growth).
+ */
+template <class Value, class MetaData, class Options>
+class log_linear : public iterator_mixin<log_linear<Value, MetaData, Options>> {
+  using value_type = Value;
+  using tick_type = detail::tick_type<value_type>;
+  using key_type = detail::log_linear_key<tick_type>;
+
+  static_assert(std::is_integral<tick_type>::value ||
+                    std::is_floating_point<tick_type>::value,
+                "log_linear axis requires floating point or integral type");
+
+  using metadata_type = detail::replace_default<MetaData, std::string>;
+  using options_type =
+      detail::replace_default<Options, decltype(option::underflow | option::overflow)>;
+
+  static_assert(!options_type::test(option::circular) &&
+                    !options_type::test(option::growth),
+                "log_linear axis cannot be circular or growing");
+
+public:
+  constexpr log_linear() = default;
+  log_linear(const log_linear&) = default;
+  log_linear& operator=(const log_linear&) = default;
+  log_linear(log_linear&& o) noexcept
+      : size_meta_(std::move(o.size_meta_))
+      , min_key_(o.min_key_)
+      , min_(o.min_)
+      , bits_(o.bits_) {
+    // std::string explicitly guarantees nothrow only in C++17
+    static_assert(std::is_same<metadata_type, std::string>::value ||
+                      std::is_nothrow_move_constructible<metadata_type>::value,
+                  "");
+  }
+  log_linear& operator=(log_linear&& o) noexcept {
+    // std::string explicitly guarantees nothrow only in C++17
+    static_assert(std::is_same<metadata_type, std::string>::value ||
+                      std::is_nothrow_move_assignable<metadata_type>::value,
+                  "");
+    size_meta_ = std::move(o.size_meta_);
+    min_key_ = o.min_key_;
+    min_ = o.min_;
+    bits_ = o.bits_;
+    return *this;
+  }
+
+  /** Construct log-linear bins over range [start, stop).
+   *
+   * @param bits     each power of two is divided into 2^bits bins.
+   * @param start    low edge of first bin, rounded down to the nearest bin edge, must be
+   *                 a positive normal number for floating point values.
+   * @param stop     high edge of last bin, rounded up to the nearest bin edge.
+   * @param meta     description of the axis (optional).
+   */
+  log_linear(unsigned bits, value_type start, value_type stop, metadata_type meta = {})
+      : size_meta_(0, std::move(meta)), bits_(bits) {
+    const auto a = detail::ticks(start);
+    const auto b = detail::ticks(stop);
+    if (bits > key_type::max_bits)
+      BOOST_THROW_EXCEPTION(std::invalid_argument("bits too large"));
+    if (detail::safe_less()(a, 0) || !(a < b) || !std::isfinite(static_cast<double>(b)))
+      BOOST_THROW_EXCEPTION(std::invalid_argument("0 <= start < stop required"));
+    // bins of floating point values below the smallest normal number would be
+    // subdivided down to the smallest subnormal number, thousands of tiny bins
+    if (std::is_floating_point<tick_type>::value && !std::isnormal(a))
+      BOOST_THROW_EXCEPTION(
+          std::invalid_argument("start must be a normal number for floating point"));
+    min_key_ = key_type::key(a, bits);
+    min_ = key_type::edge(min_key_, bits);
+    auto max_key = key_type::key(b, bits);
+    if (key_type::edge(max_key, bits) < b) ++max_key;
+    if (key_type::edge(max_key, bits) < b)
+      BOOST_THROW_EXCEPTION(std::invalid_argument("stop too large"));
+    if (max_key - min_key_ > static_cast<std::uint64_t>(
+                                 std::numeric_limits<index_type>::max() - 1))
+      BOOST_THROW_EXCEPTION(std::invalid_argument("too many bins"));
+    size_meta_.first() = static_cast<index_type>(max_key - min_key_);
+  }
+
+  /// Constructor used by algorithm::reduce to shrink (not for users).
+  log_linear(const log_linear& src, index_type begin, index_type end, unsigned merge)
+      : size_meta_(end - begin, src.metadata())
+      , min_key_(src.min_key_ + static_cast<std::uint64_t>(begin))
+      , min_(key_type::edge(min_key_, src.bits_))
+      , bits_(src.bits_) {
+    if (merge > 1)
+      BOOST_THROW_EXCEPTION(
+          std::invalid_argument("cannot merge bins for log_linear axis"));
+  }
+
+  /// Return index for value argument.
+  index_type index(value_type x) const noexcept {
+    // Runs in hot loop, please measure impact of changes
+    const auto t = detail::ticks(x);
+    if (t < min_) return -1;
+    // also reached by NaN, which has a larger key than any number
+    const auto k = key_type::key(t, bits_) - min_key_;
+    return k < static_cast<std::uint64_t>(size()) ? static_cast<index_type>(k) : size();
+  }
+
+  /// Return value for fractional index argument.
+  value_type value(real_index_type i) const noexcept {
+    if (i < 0) return detail::from_ticks<value_type>(detail::lowest<tick_type>());
+    if (i > size()) return detail::from_ticks<value_type>(detail::highest<tick_type>());
+    const auto k = std::floor(i);
+    const auto a = key_type::edge(min_key_ + static_cast<std::uint64_t>(k), bits_);
+    if (k == i) return detail::from_ticks<value_type>(a);
+    const auto b = key_type::edge(min_key_ + static_cast<std::uint64_t>(k) + 1, bits_);
+    return detail::from_ticks<value_type>(static_cast<tick_type>(a + (i - k) * (b - a)));
+  }
+
+  /// Return bin for index argument.
+  decltype(auto) bin(index_type idx) const noexcept {
+    return interval_view<log_linear>(*this, idx);
+  }
+
+  /// Returns the number of bins, without over- or underflow.
+  index_type size() const noexcept { return size_meta_.first(); }
+  /// Returns the number of bins per power of two in binary digits.
+  unsigned bits() const noexcept { return bits_; }
+  /// Returns the options.
+  static constexpr unsigned options() noexcept { return options_type::value; }
+  /// Returns reference to metadata.
+  metadata_type& metadata() noexcept { return size_meta_.second(); }
+  /// Returns reference to const metadata.
+  const metadata_type& metadata() const noexcept { return size_meta_.second(); }
+
+  template <class V, class M, class O>
+  bool operator==(const log_linear<V, M, O>& o) const noexcept {
+    return size() == o.size() && detail::relaxed_equal(metadata(), o.metadata()) &&
+           bits_ == o.bits_ && min_key_ == o.min_key_;
+  }
+
+  template <class V, class M, class O>
+  bool operator!=(const log_linear<V, M, O>& o) const noexcept {
+    return !operator==(o);
+  }
+
+  template <class Archive>
+  void serialize(Archive&, unsigned);
+
+private:
+  detail::compressed_pair<index_type, metadata_type> size_meta_{0};
+  std::uint64_t min_key_ = 0;
+  tick_type min_{0};
+  unsigned bits_ = 0;
+
+  template <class V, class M, class O>
+  friend class log_linear;
+};
+
+#if __cpp_deduction_guides >= 201606
+
+template <class T>
+log_linear(unsigned, T, T)->log_linear<T>;
+
+template <class T>
+log_linear(unsigned, T, T, const char*)->log_linear<T>;
+
+template <class T, class M>
+log_linear(unsigned, T, T, M)->log_linear<T, M>;
+
+#endif
+
+} // namespace axis
+} // namespace histogram
+} // namespace boost
+
+#endif
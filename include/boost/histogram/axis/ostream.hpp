@@ -10,12 +10,15 @@
 #define BOOST_HISTOGRAM_AXIS_OSTREAM_HPP
 
 #include <boost/assert.hpp>
+#include <boost/histogram/axis/integer_regular.hpp>
 #include <boost/histogram/axis/regular.hpp>
+#include <boost/histogram/axis/static_regular.hpp>
 #include <boost/histogram/detail/cat.hpp>
 #include <boost/histogram/detail/static_if.hpp>
 #include <boost/histogram/detail/type_name.hpp>
 #include <boost/histogram/fwd.hpp>
 #include <boost/throw_exception.hpp>
+#include <chrono>
 #include <iomanip>
 #include <iosfwd>
 #include <stdexcept>
@@ -41,6 +44,7 @@ namespace histogram {
 namespace detail {
 inline const char* axis_suffix(const axis::transform::id&) { return ""; }
 inline const char* axis_suffix(const axis::transform::log&) { return "_log"; }
+inline const char* axis_suffix(const axis::transform::fast_log&) { return "_fast_log"; }
 inline const char* axis_suffix(const axis::transform::sqrt&) { return "_sqrt"; }
 inline const char* axis_suffix(const axis::transform::pow&) { return "_pow"; }
 
@@ -98,6 +102,17 @@ void stream_value(OStream& os, const std::basic_string<Ts...>& t) {
   os << std::quoted(t);
 }
 
+// std::chrono types are streamed as tick counts
+template <class OStream, class R, class P>
+void stream_value(OStream& os, const std::chrono::duration<R, P>& t) {
+  os << t.count();
+}
+
+template <class OStream, class C, class D>
+void stream_value(OStream& os, const std::chrono::time_point<C, D>& t) {
+  os << t.time_since_epoch().count();
+}
+
 } // namespace detail
 
 namespace axis {
@@ -113,7 +128,11 @@ std::basic_ostream<Ts...>& operator<<(std::basic_ostream<Ts...>& os, const null_
 template <class... Ts, class U>
 std::basic_ostream<Ts...>& operator<<(std::basic_ostream<Ts...>& os,
                                       const interval_view<U>& i) {
-  os << "[" << i.lower() << ", " << i.upper() << ")";
+  os << "[";
+  detail::stream_value(os, i.lower());
+  os << ", ";
+  detail::stream_value(os, i.upper());
+  os << ")";
   return os;
 }
 
@@ -139,6 +158,16 @@ std::basic_ostream<Ts...>& operator<<(std::basic_ostream<Ts...>& os,
   return os;
 }
 
+template <class... Ts, unsigned B, class... Us>
+std::basic_ostream<Ts...>& operator<<(std::basic_ostream<Ts...>& os,
+                                      const static_regular<B, Us...>& a) {
+  os << "static_regular(" << a.size() << ", " << a.value(0) << ", " << a.value(a.size());
+  detail::stream_metadata(os, a.metadata());
+  detail::stream_options(os, a.options());
+  os << ")";
+  return os;
+}
+
 template <class... Ts, class... Us>
 std::basic_ostream<Ts...>& operator<<(std::basic_ostream<Ts...>& os,
                                       const integer<Us...>& a) {
@@ -149,11 +178,41 @@ std::basic_ostream<Ts...>& operator<<(std::basic_ostream<Ts...>& os,
   return os;
 }
 
+template <class... Ts, class... Us>
+std::basic_ostream<Ts...>& operator<<(std::basic_ostream<Ts...>& os,
+                                      const integer_regular<Us...>& a) {
+  os << "integer_regular(" << a.size() << ", ";
+  detail::stream_value(os, a.value(0));
+  os << ", ";
+  detail::stream_value(os, a.value(a.size()));
+  detail::stream_metadata(os, a.metadata());
+  detail::stream_options(os, a.options());
+  os << ")";
+  return os;
+}
+
+template <class... Ts, class... Us>
+std::basic_ostream<Ts...>& operator<<(std::basic_ostream<Ts...>& os,
+                                      const log_linear<Us...>& a) {
+  os << "log_linear(" << a.bits() << ", ";
+  detail::stream_value(os, a.value(0));
+  os << ", ";
+  detail::stream_value(os, a.value(a.size()));
+  detail::stream_metadata(os, a.metadata());
+  detail::stream_options(os, a.options());
+  os << ")";
+  return os;
+}
+
 template <class... Ts, class... Us>
 std::basic_ostream<Ts...>& operator<<(std::basic_ostream<Ts...>& os,
                                       const variable<Us...>& a) {
-  os << "variable(" << a.value(0);
-  for (index_type i = 1, n = a.size(); i <= n; ++i) { os << ", " << a.value(i); }
+  os << "variable(";
+  detail::stream_value(os, a.value(0));
+  for (index_type i = 1, n = a.size(); i <= n; ++i) {
+    os << ", ";
+    detail::stream_value(os, a.value(i));
+  }
   detail::stream_metadata(os, a.metadata());
   detail::stream_options(os, a.options());
   os << ")";
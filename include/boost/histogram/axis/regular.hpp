@@ -7,18 +7,24 @@
 #ifndef BOOST_HISTOGRAM_AXIS_REGULAR_HPP
 #define BOOST_HISTOGRAM_AXIS_REGULAR_HPP
 
+#include <algorithm>
 #include <boost/assert.hpp>
 #include <boost/histogram/axis/interval_view.hpp>
 #include <boost/histogram/axis/iterator.hpp>
 #include <boost/histogram/axis/option.hpp>
 #include <boost/histogram/detail/compressed_pair.hpp>
 #include <boost/histogram/detail/convert_integer.hpp>
+#include <boost/histogram/detail/detect.hpp>
 #include <boost/histogram/detail/relaxed_equal.hpp>
 #include <boost/histogram/detail/replace_default.hpp>
+#include <boost/histogram/detail/simd.hpp>
+#include <boost/histogram/detail/static_if.hpp>
 #include <boost/histogram/fwd.hpp>
+#include <boost/mp11/integral.hpp>
 #include <boost/mp11/utility.hpp>
 #include <boost/throw_exception.hpp>
 #include <cmath>
+#include <cstddef>
 #include <limits>
 #include <stdexcept>
 #include <string>
@@ -94,6 +100,42 @@ struct log {
   }
 };
 
+/**
+  Log transform for equidistant bins in log-space, which is faster than transform::log.
+
+  The forward transform is a polynomial approximation without branches, which does not
+  call std::log and is vectorized in batch fills. Its absolute error is bounded by
+  forward_error(). In batch fills, a regular axis uses the exact forward_exact() for
+  values which are so close to a bin edge that the error matters, so the bins are always
+  the same as with transform::log. Single values are always transformed exactly, since
+  std::log is as fast as the approximation without vectorization.
+ */
+struct fast_log {
+  /// Returns approximate log(x) of external value x.
+  template <typename T>
+  static T forward(T x) {
+    return detail::fast_log(x);
+  }
+
+  /// Returns log(x) of external value x.
+  template <typename T>
+  static T forward_exact(T x) {
+    return std::log(x);
+  }
+
+  /// Returns upper bound for the absolute error of forward(x) for y = forward(x).
+  template <typename T>
+  static T forward_error(T y) {
+    return static_cast<T>(1e-10) + 4 * std::numeric_limits<T>::epsilon() * std::abs(y);
+  }
+
+  /// Returns exp(x) for internal value x.
+  template <typename T>
+  static T inverse(T x) {
+    return std::exp(x);
+  }
+};
+
 /// Sqrt transform for equidistant bins in sqrt-space.
 struct sqrt {
   /// Returns sqrt(x) of external value x.
@@ -214,8 +256,8 @@ public:
           metadata_type meta = {})
       : transform_type(std::move(trans))
       , size_meta_(static_cast<index_type>(n), std::move(meta))
-      , min_(this->forward(detail::get_scale(start)))
-      , delta_(this->forward(detail::get_scale(stop)) - min_) {
+      , min_(exact_forward(detail::get_scale(start)))
+      , delta_(exact_forward(detail::get_scale(stop)) - min_) {
     if (size() == 0) BOOST_THROW_EXCEPTION(std::invalid_argument("bins > 0 required"));
     if (!std::isfinite(min_) || !std::isfinite(delta_))
       BOOST_THROW_EXCEPTION(
@@ -286,28 +328,18 @@ public:
 
   /// Return index for value argument.
   index_type index(value_type x) const noexcept {
-    // Runs in hot loop, please measure impact of changes
-    auto z = (this->forward(x / unit_type{}) - min_) / delta_;
-    if (options_type::test(option::circular)) {
-      if (std::isfinite(z)) {
-        z -= std::floor(z);
-        return static_cast<index_type>(z * size());
-      }
-    } else {
-      if (z < 1) {
-        if (z >= 0)
-          return static_cast<index_type>(z * size());
-        else
-          return -1;
-      }
-    }
-    return size(); // also returned if x is NaN
+    return internal_index(exact_forward(x / unit_type{}));
+  }
+
+  /// Compute indices for n values (used by histogram::fill, not for users).
+  void index_n(const value_type* x, index_type* out, std::size_t n) const noexcept {
+    index_n_impl(index_n_kernel{}, x, out, n);
   }
 
   /// Returns index and shift (if axis has grown) for the passed argument.
   auto update(value_type x) noexcept {
     BOOST_ASSERT(options_type::test(option::growth));
-    const auto z = (this->forward(x / unit_type{}) - min_) / delta_;
+    const auto z = (exact_forward(x / unit_type{}) - min_) / delta_;
     if (z < 1) { // don't use i here!
       if (z >= 0) {
         const auto i = static_cast<axis::index_type>(z * size());
@@ -379,6 +411,90 @@ public:
   void serialize(Archive&, unsigned);
 
 private:
+  using has_forward_exact = detail::has_method_forward_exact<transform_type>;
+
+  // vectorized kernels are available for the most common configurations
+  using index_n_kernel = mp11::mp_int<
+      (!options_type::test(option::circular) &&
+       (std::is_same<value_type, double>::value ||
+        std::is_same<value_type, float>::value))
+          ? (std::is_same<transform_type, transform::id>::value
+                 ? 1
+                 : (std::is_same<transform_type, transform::fast_log>::value ? 2 : 0))
+          : 0>;
+
+  index_type internal_index(internal_value_type y) const noexcept {
+    // Runs in hot loop, please measure impact of changes
+    auto z = (y - min_) / delta_;
+    if (options_type::test(option::circular)) {
+      if (std::isfinite(z)) {
+        z -= std::floor(z);
+        return static_cast<index_type>(z * size());
+      }
+    } else {
+      if (z < 1) {
+        if (z >= 0)
+          return static_cast<index_type>(z * size());
+        else
+          return -1;
+      }
+    }
+    return size(); // also returned if x is NaN
+  }
+
+  // transforms with an approximate forward function also provide the exact one
+  template <class T>
+  auto exact_forward(T x) const {
+    return detail::static_if<has_forward_exact>(
+        [x](const auto& t) { return t.forward_exact(x); },
+        [x](const auto& t) { return t.forward(x); }, transform());
+  }
+
+  void index_n_impl(mp11::mp_int<0>, const value_type* x, index_type* out,
+                    std::size_t n) const noexcept {
+    for (const auto end = x + n; x != end; ++x, ++out) *out = index(*x);
+  }
+
+  void index_n_impl(mp11::mp_int<1>, const value_type* x, index_type* out,
+                    std::size_t n) const noexcept {
+    // size must be exactly representable as value_type
+    const auto s = static_cast<value_type>(size());
+    if (static_cast<index_type>(s) == size())
+      detail::regular_index_n(x, out, n, min_, delta_, s);
+    else
+      index_n_impl(mp11::mp_int<0>{}, x, out, n);
+  }
+
+  // the bins of the lower and upper bound of the transformed values are computed with
+  // the vectorized kernel, values for which they differ are transformed exactly
+  void index_n_impl(mp11::mp_int<2>, const value_type* x, index_type* out,
+                    std::size_t n) const noexcept {
+    const auto s = static_cast<value_type>(size());
+    if (static_cast<index_type>(s) != size()) {
+      index_n_impl(mp11::mp_int<0>{}, x, out, n);
+      return;
+    }
+    constexpr std::size_t chunk = 256;
+    value_type lo[chunk], hi[chunk];
+    index_type upper[chunk];
+    while (n > 0) {
+      const auto m = std::min(n, chunk);
+      detail::fast_log_n(x, hi, m);
+      for (std::size_t i = 0; i < m; ++i) {
+        const auto e = this->forward_error(hi[i]);
+        lo[i] = hi[i] - e;
+        hi[i] += e;
+      }
+      detail::regular_index_n(lo, out, m, min_, delta_, s);
+      detail::regular_index_n(hi, upper, m, min_, delta_, s);
+      for (std::size_t i = 0; i < m; ++i)
+        if (out[i] != upper[i]) out[i] = internal_index(this->forward_exact(x[i]));
+      x += m;
+      out += m;
+      n -= m;
+    }
+  }
+
   detail::compressed_pair<index_type, metadata_type> size_meta_{0};
   internal_value_type min_{0}, delta_{1};
 
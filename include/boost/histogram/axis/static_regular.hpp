@@ -0,0 +1,192 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_AXIS_STATIC_REGULAR_HPP
+#define BOOST_HISTOGRAM_AXIS_STATIC_REGULAR_HPP
+
+#include <boost/histogram/axis/interval_view.hpp>
+#include <boost/histogram/axis/iterator.hpp>
+#include <boost/histogram/axis/option.hpp>
+#include <boost/histogram/detail/detect.hpp>
+#include <boost/histogram/detail/relaxed_equal.hpp>
+#include <boost/histogram/detail/replace_default.hpp>
+#include <boost/histogram/fwd.hpp>
+#include <boost/mp11/utility.hpp>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace boost {
+namespace histogram {
+namespace detail {
+
+BOOST_HISTOGRAM_DETECT(is_ratio, (T::num + T::den));
+
+template <class R, class T>
+constexpr R static_value(std::true_type) noexcept {
+  return static_cast<R>(T::num) / static_cast<R>(T::den);
+}
+
+template <class R, class T>
+constexpr R static_value(std::false_type) noexcept {
+  return static_cast<R>(T::value);
+}
+
+// value of std::ratio or a type with a static value member, like std::integral_constant
+template <class R, class T>
+constexpr R static_value() noexcept {
+  return static_value<R, T>(is_ratio<T>{});
+}
+
+} // namespace detail
+
+namespace axis {
+
+#if __cpp_nontype_template_args >= 201911L
+/// Floating point constant to use as start or stop of a static_regular axis (C++20).
+template <double Value>
+struct constant {
+  static constexpr double value = Value;
+};
+#endif
+
+/**
+  Axis for equidistant intervals on the real line with compile-time parameters.
+
+  Like a regular axis with the identity transform, but the number of bins and the range
+  are template arguments, so that the scale of the axis is a compile-time constant.
+  Computing the bin is a subtraction, a multiplication, and a truncation, which do not
+  load the parameters from memory. The axis only stores its metadata.
+
+  The bin of a value is computed from the product of its distance to start with the
+  constant size / (stop - start). If the number of bins and the width of the range are
+  powers of two, this product is exact and the bins are exactly the same as those of a
+  regular axis, otherwise they may differ for values within round-off of a bin edge.
+
+  @tparam Bins number of bins.
+  @tparam Start low edge of first bin, std::ratio or type with static member value.
+  @tparam Stop high edge of last bin, std::ratio or type with static member value.
+  @tparam Value input value type, must be floating point.
+  @tparam MetaData type to store meta data.
+  @tparam Options see boost::histogram::axis::option (no growth).
+ */
+template <unsigned Bins, class Start, class Stop, class Value, class MetaData,
+          class Options>
+class static_regular
+    : public iterator_mixin<static_regular<Bins, Start, Stop, Value, MetaData, Options>> {
+  using value_type = Value;
+  using metadata_type = detail::replace_default<MetaData, std::string>;
+  using options_type =
+      detail::replace_default<Options, decltype(option::underflow | option::overflow)>;
+
+  static_assert(std::is_floating_point<value_type>::value,
+                "static_regular axis requires floating point type");
+  static_assert(Bins > 0, "bins > 0 required");
+  static_assert(detail::static_value<value_type, Start>() <
+                    detail::static_value<value_type, Stop>(),
+                "start < stop required");
+  static_assert(!options_type::test(option::growth),
+                "static_regular axis cannot grow");
+
+public:
+  static_regular() = default;
+
+  /** Construct axis with metadata.
+   *
+   * @param meta     description of the axis.
+   */
+  explicit static_regular(metadata_type meta) : meta_(std::move(meta)) {}
+
+  /// Return index for value argument.
+  index_type index(value_type x) const noexcept {
+    // Runs in hot loop, please measure impact of changes
+    if (options_type::test(option::circular)) {
+      constexpr auto scale = 1 / (stop() - start());
+      auto z = (x - start()) * scale;
+      if (std::isfinite(z)) {
+        z -= std::floor(z);
+        return static_cast<index_type>(z * Bins);
+      }
+    } else {
+      constexpr auto scale = Bins / (stop() - start());
+      const auto z = (x - start()) * scale;
+      if (z < Bins) {
+        if (z >= 0)
+          return static_cast<index_type>(z);
+        else
+          return -1;
+      }
+    }
+    return Bins; // also returned if x is NaN
+  }
+
+  /// Compute indices for n values (used by histogram::fill, not for users).
+  void index_n(const value_type* x, index_type* out, std::size_t n) const noexcept {
+    // loop with constant parameters is unrolled and vectorized by the compiler
+    for (const auto end = x + n; x != end; ++x, ++out) *out = index(*x);
+  }
+
+  /// Return value for fractional index argument.
+  value_type value(real_index_type i) const noexcept {
+    const auto z = i / Bins;
+    if (!options_type::test(option::circular)) {
+      if (z < 0) return -std::numeric_limits<value_type>::infinity();
+      if (z > 1) return std::numeric_limits<value_type>::infinity();
+    }
+    return static_cast<value_type>((1 - z) * start() + z * stop());
+  }
+
+  /// Return bin for index argument.
+  decltype(auto) bin(index_type idx) const noexcept {
+    return interval_view<static_regular>(*this, idx);
+  }
+
+  /// Returns the number of bins, without over- or underflow.
+  static constexpr index_type size() noexcept { return Bins; }
+  /// Returns the options.
+  static constexpr unsigned options() noexcept { return options_type::value; }
+  /// Returns reference to metadata.
+  metadata_type& metadata() noexcept { return meta_; }
+  /// Returns reference to const metadata.
+  const metadata_type& metadata() const noexcept { return meta_; }
+
+  template <unsigned B, class S, class T, class V, class M, class O>
+  bool operator==(const static_regular<B, S, T, V, M, O>& o) const noexcept {
+    return Bins == B && start() == o.start() && stop() == o.stop() &&
+           detail::relaxed_equal(metadata(), o.metadata());
+  }
+
+  template <unsigned B, class S, class T, class V, class M, class O>
+  bool operator!=(const static_regular<B, S, T, V, M, O>& o) const noexcept {
+    return !operator==(o);
+  }
+
+  template <class Archive>
+  void serialize(Archive&, unsigned);
+
+private:
+  static constexpr value_type start() noexcept {
+    return detail::static_value<value_type, Start>();
+  }
+
+  static constexpr value_type stop() noexcept {
+    return detail::static_value<value_type, Stop>();
+  }
+
+  metadata_type meta_;
+
+  template <unsigned B, class S, class T, class V, class M, class O>
+  friend class static_regular;
+};
+
+} // namespace axis
+} // namespace histogram
+} // namespace boost
+
+#endif
@@ -156,16 +156,23 @@ Result value_as(const Axis& axis, real_index_type index) {
 
 /** Returns axis index for value.
 
-  Throws std::invalid_argument if the value argument is not implicitly convertible.
+  If the axis has a method `find` which accepts the value argument, call it and return
+  the result; this avoids a conversion of the value argument. Otherwise, throws
+  std::invalid_argument if the value argument is not implicitly convertible.
 
   @param axis any axis instance
-  @param value argument to be passed to `index` method
+  @param value argument to be passed to `find` or `index` method
 */
 template <class Axis, class U,
           class _V = std::decay_t<detail::arg_type<decltype(&Axis::index)>>>
 axis::index_type index(const Axis& axis,
                        const U& value) noexcept(std::is_convertible<U, _V>::value) {
-  return axis.index(detail::try_cast<_V, std::invalid_argument>(value));
+  return detail::static_if<detail::has_method_find<Axis, U>>(
+      [&value](const auto& a) { return a.find(value); },
+      [&value](const auto& a) {
+        return a.index(detail::try_cast<_V, std::invalid_argument>(value));
+      },
+      axis);
 }
 
 // specialization for variant
@@ -179,11 +186,12 @@ axis::index_type index(const variant<Ts...>& axis, const U& value) {
   Throws `std::invalid_argument` if the value argument is not implicitly convertible to
   the argument expected by the `index` method. If the result of
   boost::histogram::axis::traits::static_options<decltype(axis)> has the growth flag set,
-  call `update` method with the argument and return the result. Otherwise, call `index`
+  call `update` method with the argument and return the result, or the `emplace` method,
+  if the axis has a method `emplace` which accepts the argument. Otherwise, call `index`
   and return the pair of the result and a zero shift.
 
   @param axis any axis instance
-  @param value argument to be passed to `update` or `index` method
+  @param value argument to be passed to `update`, `emplace`, or `index` method
 */
 template <class Axis, class U,
           class _V = std::decay_t<detail::arg_type<decltype(&Axis::index)>>>
@@ -191,7 +199,12 @@ std::pair<index_type, index_type> update(Axis& axis, const U& value) noexcept(
     std::is_convertible<U, _V>::value) {
   return detail::static_if_c<static_options<Axis>::test(option::growth)>(
       [&value](auto& a) {
-        return a.update(detail::try_cast<_V, std::invalid_argument>(value));
+        return detail::static_if<detail::has_method_emplace<Axis, U>>(
+            [&value](auto& b) { return b.emplace(value); },
+            [&value](auto& b) {
+              return b.update(detail::try_cast<_V, std::invalid_argument>(value));
+            },
+            a);
       },
       [&value](auto& a) { return std::make_pair(index(a, value), index_type{0}); }, axis);
 }
@@ -12,12 +12,17 @@
 #include <boost/histogram/axis/interval_view.hpp>
 #include <boost/histogram/axis/iterator.hpp>
 #include <boost/histogram/axis/option.hpp>
+#include <boost/histogram/detail/chrono.hpp>
 #include <boost/histogram/detail/compressed_pair.hpp>
 #include <boost/histogram/detail/convert_integer.hpp>
 #include <boost/histogram/detail/detect.hpp>
+#include <boost/histogram/detail/eytzinger_index.hpp>
+#include <boost/histogram/detail/gallop.hpp>
+#include <boost/histogram/detail/grid_index.hpp>
 #include <boost/histogram/detail/limits.hpp>
 #include <boost/histogram/detail/relaxed_equal.hpp>
 #include <boost/histogram/detail/replace_default.hpp>
+#include <boost/histogram/detail/simd.hpp>
 #include <boost/histogram/fwd.hpp>
 #include <boost/throw_exception.hpp>
 #include <cmath>
@@ -29,6 +34,14 @@
 #include <utility>
 #include <vector>
 
+/** Minimum number of bin edges for which a variable axis builds a search index.
+ *
+ * Below this size, comparing the value with all edges is faster.
+ */
+#ifndef BOOST_HISTOGRAM_DETAIL_VARIABLE_SEARCH_THRESHOLD
+#define BOOST_HISTOGRAM_DETAIL_VARIABLE_SEARCH_THRESHOLD 24
+#endif
+
 namespace boost {
 namespace histogram {
 namespace axis {
@@ -37,30 +50,54 @@ namespace axis {
   Axis for non-equidistant bins on the real line.
 
   Binning is a O(log(N)) operation. If speed matters and the problem domain
-  allows it, prefer a regular axis, possibly with a transform.
-
-  @tparam Value input value type, must be floating point.
+  allows it, prefer a regular axis, possibly with a transform. If there are few edges,
+  the value is compared with all of them without branches, using SIMD instructions
+  where available. For many edges which are roughly equidistant, the axis keeps a
+  regular grid over its range, so that binning is O(1): the grid cell of the value is
+  computed like for a regular axis and the value is compared only with the few edges in
+  that cell. Otherwise, the axis keeps a copy of the edges in Eytzinger layout, which is
+  searched without branches and with fewer cache misses.
+
+  The axis also accepts std::chrono::duration and std::chrono::time_point values. The
+  edges are stored as tick counts and values are compared on their tick count, so that
+  integral ticks are binned exactly. Bin edges are returned in the value type. Axes over
+  integral ticks cannot be circular or growing.
+
+  @tparam Value input value type, floating point or std::chrono type.
   @tparam MetaData type to store meta data.
   @tparam Options see boost::histogram::axis::option (all values allowed).
   @tparam Allocator allocator to use for dynamic memory management.
  */
 template <class Value, class MetaData, class Options, class Allocator>
 class variable : public iterator_mixin<variable<Value, MetaData, Options, Allocator>> {
-  static_assert(std::is_floating_point<Value>::value,
-                "variable axis requires floating point type");
-
   using value_type = Value;
+  using tick_type = detail::tick_type<value_type>;
   using metadata_type = detail::replace_default<MetaData, std::string>;
   using options_type =
       detail::replace_default<Options, decltype(option::underflow | option::overflow)>;
   using allocator_type = Allocator;
-  using vec_type = std::vector<Value, allocator_type>;
+  using tick_allocator_type =
+      typename std::allocator_traits<allocator_type>::template rebind_alloc<tick_type>;
+  using vec_type = std::vector<tick_type, tick_allocator_type>;
+
+  static_assert(std::is_floating_point<tick_type>::value ||
+                    (detail::is_chrono<value_type>::value &&
+                     std::is_integral<tick_type>::value),
+                "variable axis requires floating point or std::chrono type");
+  static_assert(std::is_floating_point<tick_type>::value ||
+                    !(options_type::test(option::circular) ||
+                      options_type::test(option::growth)),
+                "variable axis with integral ticks cannot be circular or growing");
 
 public:
-  explicit variable(allocator_type alloc = {}) : vec_meta_(vec_type{alloc}) {}
+  explicit variable(allocator_type alloc = {})
+      : vec_meta_(vec_type{alloc}), grid_(alloc), search_(alloc) {}
   variable(const variable&) = default;
   variable& operator=(const variable&) = default;
-  variable(variable&& o) noexcept : vec_meta_(std::move(o.vec_meta_)) {
+  variable(variable&& o) noexcept
+      : vec_meta_(std::move(o.vec_meta_)),
+        grid_(std::move(o.grid_)),
+        search_(std::move(o.search_)) {
     // std::string explicitly guarantees nothrow only in C++17
     static_assert(std::is_same<metadata_type, std::string>::value ||
                       std::is_nothrow_move_constructible<metadata_type>::value,
@@ -72,6 +109,8 @@ public:
                       std::is_nothrow_move_assignable<metadata_type>::value,
                   "");
     vec_meta_ = std::move(o.vec_meta_);
+    grid_ = std::move(o.grid_);
+    search_ = std::move(o.search_);
     return *this;
   }
 
@@ -84,19 +123,21 @@ public:
    */
   template <class It, class = detail::requires_iterator<It>>
   variable(It begin, It end, metadata_type meta = {}, allocator_type alloc = {})
-      : vec_meta_(vec_type(std::move(alloc)), std::move(meta)) {
+      : vec_meta_(vec_type(alloc), std::move(meta)), grid_(alloc), search_(alloc) {
     if (std::distance(begin, end) <= 1)
       BOOST_THROW_EXCEPTION(std::invalid_argument("bins > 0 required"));
 
     auto& v = vec_meta_.first();
     v.reserve(std::distance(begin, end));
-    v.emplace_back(*begin++);
+    v.emplace_back(detail::ticks(static_cast<value_type>(*begin++)));
     while (begin != end) {
-      if (*begin <= v.back())
+      const auto t = detail::ticks(static_cast<value_type>(*begin++));
+      if (t <= v.back())
         BOOST_THROW_EXCEPTION(
             std::invalid_argument("input sequence must be strictly ascending"));
-      v.emplace_back(*begin++);
+      v.emplace_back(t);
     }
+    rebuild_search();
   }
 
   /** Construct variable axis from iterable range of bin edges.
@@ -123,7 +164,9 @@ public:
 
   /// Constructor used by algorithm::reduce to shrink and rebin (not for users).
   variable(const variable& src, index_type begin, index_type end, unsigned merge)
-      : vec_meta_(vec_type(src.get_allocator()), src.metadata()) {
+      : vec_meta_(vec_type(src.get_allocator()), src.metadata()),
+        grid_(src.get_allocator()),
+        search_(src.get_allocator()) {
     BOOST_ASSERT((end - begin) % merge == 0);
     if (options_type::test(option::circular) && !(begin == 0 && end == src.size()))
       BOOST_THROW_EXCEPTION(std::invalid_argument("cannot shrink circular axis"));
@@ -131,58 +174,83 @@ public:
     vec.reserve((end - begin) / merge);
     const auto beg = src.vec_meta_.first().begin();
     for (index_type i = begin; i <= end; i += merge) vec.emplace_back(*(beg + i));
+    rebuild_search();
   }
 
   /// Return index for value argument.
   index_type index(value_type x) const noexcept {
+    return static_cast<index_type>(search(wrap(detail::ticks(x)))) - 1;
+  }
+
+  /** Return index for value argument, searching first near the hint.
+
+    The search gallops outward from the hint, so it is fast if the hint is the index of
+    a nearby value, for example the previous value of a slowly changing sequence. The
+    result does not depend on the hint.
+
+    @param x     input value.
+    @param hint  any index, usually the result of a previous call.
+   */
+  index_type index_near(value_type x, index_type hint) const noexcept {
     const auto& v = vec_meta_.first();
-    if (options_type::test(option::circular)) {
-      const auto a = v[0];
-      const auto b = v[size()];
-      x -= std::floor((x - a) / (b - a)) * (b - a);
+    const auto t = wrap(detail::ticks(x));
+    const auto k = static_cast<std::size_t>(std::min(std::max(hint, -1), size()) + 1);
+    const auto p = detail::gallop_upper_bound(v.data(), v.size(), t, k);
+    return static_cast<index_type>(p <= v.size() ? p : search(t)) - 1;
+  }
+
+  /// Compute indices for n values (used by histogram::fill, not for users).
+  void index_n(const value_type* x, index_type* out, std::size_t n) const noexcept {
+    // If the first values are mostly in the same or neighboring bins, the remaining
+    // values are found by galloping from the position of the previous value.
+    const auto& v = vec_meta_.first();
+    const auto m = std::min(n, gallop_sample);
+    std::size_t k = 0, near = 0;
+    for (std::size_t i = 0; i < m; ++i) {
+      const auto p = search(wrap(detail::ticks(x[i])));
+      near += i > 0 && p + 1 >= k && p <= k + 1;
+      k = p;
+      out[i] = static_cast<index_type>(p) - 1;
+    }
+    if (4 * near < 3 * m) {
+      for (std::size_t i = m; i < n; ++i) out[i] = index(x[i]);
+      return;
+    }
+    for (std::size_t i = m; i < n; ++i) {
+      const auto xi = wrap(detail::ticks(x[i]));
+      auto p = detail::gallop_upper_bound(v.data(), v.size(), xi, k);
+      if (p > v.size()) p = search(xi);
+      k = p;
+      out[i] = static_cast<index_type>(p) - 1;
     }
-    return static_cast<index_type>(std::upper_bound(v.begin(), v.end(), x) - v.begin() -
-                                   1);
   }
 
   auto update(value_type x) noexcept {
     const auto i = index(x);
-    if (std::isfinite(x)) {
+    auto t = detail::ticks(x);
+    if (std::isfinite(t)) {
       auto& vec = vec_meta_.first();
       if (0 <= i) {
         if (i < size()) return std::make_pair(i, 0);
-        const auto d = value(size()) - value(size() - 0.5);
-        x = std::nextafter(x, std::numeric_limits<value_type>::max());
-        x = std::max(x, vec.back() + d);
-        vec.push_back(x);
+        const auto d = tick_value(size()) - tick_value(size() - 0.5);
+        t = std::nextafter(t, std::numeric_limits<tick_type>::max());
+        t = std::max(t, vec.back() + d);
+        vec.push_back(t);
+        rebuild_search();
         return std::make_pair(i, -1);
       }
-      const auto d = value(0.5) - value(0);
-      x = std::min(x, value(0) - d);
-      vec.insert(vec.begin(), x);
+      const auto d = tick_value(0.5) - tick_value(0);
+      t = std::min(t, tick_value(0) - d);
+      vec.insert(vec.begin(), t);
+      rebuild_search();
       return std::make_pair(0, -i);
     }
-    return std::make_pair(x < 0 ? -1 : size(), 0);
+    return std::make_pair(t < 0 ? -1 : size(), 0);
   }
 
   /// Return value for fractional index argument.
   value_type value(real_index_type i) const noexcept {
-    const auto& v = vec_meta_.first();
-    if (options_type::test(option::circular)) {
-      auto shift = std::floor(i / size());
-      i -= shift * size();
-      double z;
-      const auto k = static_cast<index_type>(std::modf(i, &z));
-      const auto a = v[0];
-      const auto b = v[size()];
-      return (1.0 - z) * v[k] + z * v[k + 1] + shift * (b - a);
-    }
-    if (i < 0) return detail::lowest<value_type>();
-    if (i == size()) return v.back();
-    if (i > size()) return detail::highest<value_type>();
-    const auto k = static_cast<index_type>(i); // precond: i >= 0
-    const real_index_type z = i - k;
-    return (1.0 - z) * v[k] + z * v[k + 1];
+    return detail::from_ticks<value_type>(tick_value(i));
   }
 
   /// Return bin for index argument.
@@ -219,12 +287,71 @@ public:
   void serialize(Archive&, unsigned);
 
 private:
+  // number of values from which index_n decides whether to use a galloping search
+  static constexpr std::size_t gallop_sample = 32;
+
+  tick_type tick_value(real_index_type i) const noexcept {
+    const auto& v = vec_meta_.first();
+    if (options_type::test(option::circular)) {
+      auto shift = std::floor(i / size());
+      i -= shift * size();
+      double z;
+      const auto k = static_cast<index_type>(std::modf(i, &z));
+      const auto a = v[0];
+      const auto b = v[size()];
+      return static_cast<tick_type>((1.0 - z) * v[k] + z * v[k + 1] + shift * (b - a));
+    }
+    if (i < 0) return detail::lowest<tick_type>();
+    if (i == size()) return v.back();
+    if (i > size()) return detail::highest<tick_type>();
+    const auto k = static_cast<index_type>(i); // precond: i >= 0
+    const real_index_type z = i - k;
+    // integral edges are returned exactly, they may not be representable as double
+    if (!std::is_floating_point<tick_type>::value)
+      return v[k] + static_cast<tick_type>(z * (v[k + 1] - v[k]));
+    return static_cast<tick_type>((1.0 - z) * v[k] + z * v[k + 1]);
+  }
+
+  tick_type wrap(tick_type x) const noexcept {
+    if (options_type::test(option::circular)) {
+      const auto& v = vec_meta_.first();
+      const auto a = v[0];
+      const auto b = v[size()];
+      x -= static_cast<tick_type>(std::floor((x - a) / (b - a)) * (b - a));
+    }
+    return x;
+  }
+
+  // same result as std::upper_bound, also for NaN
+  std::size_t search(tick_type x) const noexcept {
+    const auto& v = vec_meta_.first();
+    if (!grid_.empty()) return grid_.find(v, x);
+    if (!search_.empty()) return search_.find(v, x);
+    return detail::upper_bound_scan(v.data(), v.size(), x);
+  }
+
+  void rebuild_search() {
+    const auto& v = vec_meta_.first();
+    grid_.rebuild(v, BOOST_HISTOGRAM_DETAIL_VARIABLE_SEARCH_THRESHOLD);
+    if (grid_.empty())
+      search_.rebuild(v, BOOST_HISTOGRAM_DETAIL_VARIABLE_SEARCH_THRESHOLD);
+    else
+      search_.clear();
+  }
+
   detail::compressed_pair<vec_type, metadata_type> vec_meta_;
+  // regular grid over the edges, if they are roughly equidistant
+  detail::grid_index<tick_allocator_type> grid_;
+  // copy of the edges for a fast search, if there is no grid and many edges
+  detail::eytzinger_index<tick_allocator_type> search_;
 
   template <class V, class M, class O, class A>
   friend class variable;
 };
 
+template <class Value, class MetaData, class Options, class Allocator>
+constexpr std::size_t variable<Value, MetaData, Options, Allocator>::gallop_sample;
+
 #if __cpp_deduction_guides >= 201606
 
 template <class U, class T = detail::convert_integer<U, double>>
@@ -0,0 +1,247 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_BUFFERED_STORAGE_HPP
+#define BOOST_HISTOGRAM_BUFFERED_STORAGE_HPP
+
+#include <boost/histogram/detail/detect.hpp>
+#include <boost/histogram/detail/per_thread.hpp>
+#include <boost/histogram/fwd.hpp>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace boost {
+namespace histogram {
+namespace detail {
+
+BOOST_HISTOGRAM_DETECT(has_method_load, (std::declval<const T&>().load()));
+
+// type of the increments which are added to a cell of type T
+template <class T, bool = has_method_load<T>::value>
+struct increment_type {
+  using type = T;
+};
+
+template <class T>
+struct increment_type<T, true> {
+  using type = std::decay_t<decltype(std::declval<const T&>().load())>;
+};
+
+} // namespace detail
+
+/** Storage adaptor which combines increments in a small buffer for each thread.
+
+  Concurrent filling of a storage with atomic counters is slow if many threads increment
+  the same cells, since the cache line of the cell is then moved between the CPU cores
+  on every increment. This adaptor gives each thread a small buffer of (index,
+  increment) pairs in front of a thread-safe storage. Repeated increments of the same
+  cell are added up in the buffer, and only one atomic addition per buffered cell is
+  done when the cell is evicted from the buffer or when the buffers are flushed. Unlike
+  sharded_storage, the memory overhead per thread does not depend on the number of
+  cells, so this adaptor is suitable for large histograms with a skewed distribution of
+  values.
+
+  The buffer is direct-mapped: cell i is buffered in slot i modulo BufferSize, so that
+  neighboring cells do not evict each other. The buffers are flushed whenever the cells
+  are read, or explicitly with flush(). Reading cells must therefore not happen
+  concurrently with filling, like for sharded_storage.
+
+  @tparam Storage thread-safe storage of counters, for example
+  `dense_storage<accumulators::thread_safe<unsigned>>`.
+  @tparam BufferSize number of buffered cells per thread, must be a power of 2.
+ */
+template <class Storage, std::size_t BufferSize>
+class buffered_storage {
+  static_assert(Storage::has_threading_support,
+                "buffered_storage requires a thread-safe storage");
+  static_assert(BufferSize > 0 && (BufferSize & (BufferSize - 1)) == 0,
+                "BufferSize must be a power of 2");
+
+  using increment_type =
+      typename detail::increment_type<typename Storage::value_type>::type;
+
+  static constexpr std::size_t empty = ~static_cast<std::size_t>(0);
+
+  struct buffer_type;
+
+  // only increments are supported
+  class buffer_reference {
+  public:
+    void operator++() { buffer_.add(index_, static_cast<increment_type>(1)); }
+
+    template <class T>
+    void operator+=(const T& x) {
+      buffer_.add(index_, static_cast<increment_type>(x));
+    }
+
+  private:
+    buffer_reference(buffer_type& b, std::size_t i) noexcept : buffer_(b), index_(i) {}
+
+    buffer_type& buffer_;
+    std::size_t index_;
+
+    friend struct buffer_type;
+  };
+
+  struct buffer_type {
+    using value_type = typename Storage::value_type;
+    using iterator = typename Storage::iterator;
+
+    buffer_reference operator[](std::size_t i) noexcept { return {*this, i}; }
+    iterator begin() { return target->begin(); }
+
+    void add(const std::size_t i, const increment_type x) {
+      auto& slot = slots[i & (BufferSize - 1)];
+      if (slot.index == i) {
+        slot.value += x;
+        return;
+      }
+      if (slot.index != empty) (*target)[slot.index] += slot.value;
+      slot.index = i;
+      slot.value = x;
+      dirty = true;
+    }
+
+    void flush() {
+      if (!dirty) return;
+      for (auto&& slot : slots) {
+        if (slot.index == empty) continue;
+        (*target)[slot.index] += slot.value;
+        slot.index = empty;
+      }
+      dirty = false;
+    }
+
+    void clear() noexcept {
+      for (auto&& slot : slots) slot.index = empty;
+      dirty = false;
+    }
+
+    struct slot_type {
+      std::size_t index = empty;
+      increment_type value;
+    } slots[BufferSize];
+    Storage* target = nullptr;
+    bool dirty = false;
+  };
+
+public:
+  using storage_type = Storage;
+  using value_type = typename Storage::value_type;
+  using reference = typename Storage::reference;
+  using const_reference = typename Storage::const_reference;
+  using iterator = typename Storage::iterator;
+  using const_iterator = typename Storage::const_iterator;
+
+  static constexpr bool has_threading_support = true;
+
+  buffered_storage() = default;
+
+  explicit buffered_storage(const Storage& s) : merged_(s) {}
+  explicit buffered_storage(Storage&& s) : merged_(std::move(s)) {}
+
+  // copies contain only the flushed cells
+  buffered_storage(const buffered_storage& o) : merged_((o.flush(), o.merged_)) {}
+
+  buffered_storage& operator=(const buffered_storage& o) {
+    if (this != &o) {
+      o.flush();
+      merged_ = o.merged_;
+      buffers_.clear();
+    }
+    return *this;
+  }
+
+  // buffers are flushed before the move, since they point to the source storage
+  buffered_storage(buffered_storage&& o)
+      : merged_((o.flush(), std::move(o.merged_))), buffers_(std::move(o.buffers_)) {
+    retarget();
+  }
+
+  buffered_storage& operator=(buffered_storage&& o) {
+    if (this != &o) {
+      o.flush();
+      merged_ = std::move(o.merged_);
+      buffers_ = std::move(o.buffers_);
+      retarget();
+    }
+    return *this;
+  }
+
+  void reset(std::size_t n) {
+    merged_.reset(n);
+    buffers_.for_each([](buffer_type& b) { b.clear(); });
+  }
+
+  std::size_t size() const noexcept { return merged_.size(); }
+
+  reference operator[](std::size_t i) {
+    flush();
+    return merged_[i];
+  }
+  const_reference operator[](std::size_t i) const {
+    flush();
+    return merged_[i];
+  }
+
+  bool operator==(const buffered_storage& o) const {
+    flush();
+    o.flush();
+    return merged_ == o.merged_;
+  }
+
+  template <class U, class = detail::requires_iterable<U>>
+  bool operator==(const U& u) const {
+    flush();
+    return merged_ == u;
+  }
+
+  buffered_storage& operator*=(const double x) {
+    flush();
+    merged_ *= x;
+    return *this;
+  }
+
+  iterator begin() {
+    flush();
+    return merged_.begin();
+  }
+  iterator end() { return merged_.end(); }
+  const_iterator begin() const {
+    flush();
+    return merged_.begin();
+  }
+  const_iterator end() const { return merged_.end(); }
+
+  /// Add the buffered increments of all threads to the storage.
+  void flush() const {
+    buffers_.for_each([](buffer_type& b) { b.flush(); });
+  }
+
+  /// Buffer of the calling thread; the first call from a thread allocates it.
+  buffer_type& shard() {
+    auto& b = buffers_.local([] { return buffer_type{}; });
+    // storage may have been moved since the last call
+    b.target = &merged_;
+    return b;
+  }
+
+private:
+  void retarget() {
+    buffers_.for_each([this](buffer_type& b) { b.target = &merged_; });
+  }
+
+  mutable Storage merged_;
+  mutable detail::per_thread<buffer_type> buffers_;
+
+  friend struct unsafe_access;
+};
+
+} // namespace histogram
+} // namespace boost
+
+#endif
@@ -190,17 +190,38 @@ void for_each_axis_impl(std::false_type, const T& axes, F&& f) {
   for (const auto& x : axes) std::forward<F>(f)(x);
 }
 
+template <typename F, typename T>
+void for_each_axis_impl(std::true_type, T& axes, F&& f) {
+  for (auto& x : axes) { axis::visit(std::forward<F>(f), x); }
+}
+
+template <typename F, typename T>
+void for_each_axis_impl(std::false_type, T& axes, F&& f) {
+  for (auto& x : axes) std::forward<F>(f)(x);
+}
+
 template <typename F, typename T>
 void for_each_axis(const T& axes, F&& f) {
   using U = mp11::mp_first<T>;
   for_each_axis_impl(is_axis_variant<U>(), axes, std::forward<F>(f));
 }
 
+template <typename F, typename T>
+void for_each_axis(T& axes, F&& f) {
+  using U = mp11::mp_first<T>;
+  for_each_axis_impl(is_axis_variant<U>(), axes, std::forward<F>(f));
+}
+
 template <typename F, typename... Ts>
 void for_each_axis(const std::tuple<Ts...>& axes, F&& f) {
   mp11::tuple_for_each(axes, std::forward<F>(f));
 }
 
+template <typename F, typename... Ts>
+void for_each_axis(std::tuple<Ts...>& axes, F&& f) {
+  mp11::tuple_for_each(axes, std::forward<F>(f));
+}
+
 template <typename T>
 std::size_t bincount(const T& axes) {
   std::size_t n = 1;
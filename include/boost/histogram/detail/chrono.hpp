@@ -0,0 +1,71 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_DETAIL_CHRONO_HPP
+#define BOOST_HISTOGRAM_DETAIL_CHRONO_HPP
+
+#include <chrono>
+#include <type_traits>
+
+namespace boost {
+namespace histogram {
+namespace detail {
+
+/*
+  Tick counts of std::chrono types.
+
+  Axes bin std::chrono::duration and std::chrono::time_point values on their tick count,
+  which is an integer for the standard durations, and convert bin edges back to the
+  original type. Other types are their own tick count.
+*/
+template <class T>
+struct tick_traits {
+  using type = T;
+  static constexpr type count(const T& x) noexcept { return x; }
+  static constexpr T make(const type& t) noexcept { return t; }
+};
+
+template <class Rep, class Period>
+struct tick_traits<std::chrono::duration<Rep, Period>> {
+  using duration = std::chrono::duration<Rep, Period>;
+  using type = Rep;
+  static constexpr type count(const duration& x) noexcept { return x.count(); }
+  static constexpr duration make(const type& t) noexcept { return duration(t); }
+};
+
+template <class Clock, class Duration>
+struct tick_traits<std::chrono::time_point<Clock, Duration>> {
+  using duration = Duration;
+  using type = typename Duration::rep;
+  static constexpr type count(const std::chrono::time_point<Clock, Duration>& x) noexcept {
+    return x.time_since_epoch().count();
+  }
+  static constexpr std::chrono::time_point<Clock, Duration> make(const type& t) noexcept {
+    return std::chrono::time_point<Clock, Duration>(Duration(t));
+  }
+};
+
+template <class T>
+using tick_type = typename tick_traits<T>::type;
+
+template <class T>
+using is_chrono = std::integral_constant<bool, !std::is_same<tick_type<T>, T>::value>;
+
+template <class T>
+constexpr tick_type<T> ticks(const T& x) noexcept {
+  return tick_traits<T>::count(x);
+}
+
+template <class T>
+constexpr T from_ticks(const tick_type<T>& t) noexcept {
+  return tick_traits<T>::make(t);
+}
+
+} // namespace detail
+} // namespace histogram
+} // namespace boost
+
+#endif
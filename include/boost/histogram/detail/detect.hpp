@@ -39,14 +39,38 @@ BOOST_HISTOGRAM_DETECT(has_method_resize, (std::declval<T&>().resize(0)));
 
 BOOST_HISTOGRAM_DETECT(has_method_size, &T::size);
 
+BOOST_HISTOGRAM_DETECT(has_method_capacity, (std::declval<const T&>().capacity()));
+
+// reserve may have overloads, trying to get pmf in this case always fails
+BOOST_HISTOGRAM_DETECT(has_method_reserve, (std::declval<T&>().reserve(0)));
+
 BOOST_HISTOGRAM_DETECT(has_method_clear, &T::clear);
 
+BOOST_HISTOGRAM_DETECT(has_method_shard, (std::declval<T&>().shard()));
+
+BOOST_HISTOGRAM_DETECT(is_executor,
+                       (std::declval<T&>().run(
+                            std::size_t{},
+                            std::declval<void (*)(std::size_t, std::size_t)>()),
+                        std::declval<const T&>().size()));
+
 BOOST_HISTOGRAM_DETECT(has_method_lower, &T::lower);
 
 BOOST_HISTOGRAM_DETECT(has_method_value, &T::value);
 
 BOOST_HISTOGRAM_DETECT(has_method_update, (&T::update));
 
+BOOST_HISTOGRAM_DETECT(has_method_forward_exact,
+                       (std::declval<const T&>().forward_exact(0.0)));
+
+// axis supports lookup of U without conversion
+BOOST_HISTOGRAM_DETECT_BINARY(has_method_find,
+                              (std::declval<const T&>().find(std::declval<const U&>())));
+
+// axis can insert U without conversion
+BOOST_HISTOGRAM_DETECT_BINARY(has_method_emplace,
+                              (std::declval<T&>().emplace(std::declval<const U&>())));
+
 // reset has overloads, trying to get pmf in this case always fails
 BOOST_HISTOGRAM_DETECT(has_method_reset, (std::declval<T>().reset(0)));
 
@@ -178,6 +202,9 @@ template <class T, class = std::enable_if_t<
                        is_iterable<std::remove_cv_t<std::remove_reference_t<T>>>::value>>
 struct requires_iterable {};
 
+template <class T, class = std::enable_if_t<is_executor<std::decay_t<T>>::value>>
+struct requires_executor {};
+
 template <class T, class = std::enable_if_t<is_axis<std::decay_t<T>>::value>>
 struct requires_axis {};
 
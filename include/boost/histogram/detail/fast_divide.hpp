@@ -0,0 +1,89 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_DETAIL_FAST_DIVIDE_HPP
+#define BOOST_HISTOGRAM_DETAIL_FAST_DIVIDE_HPP
+
+#include <cstdint>
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+#include <intrin.h>
+#endif
+
+namespace boost {
+namespace histogram {
+namespace detail {
+
+// position of the highest set bit, x must not be zero
+inline unsigned highest_bit(std::uint64_t x) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  return 63 - static_cast<unsigned>(__builtin_clzll(x));
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+  unsigned long i;
+  _BitScanReverse64(&i, x);
+  return static_cast<unsigned>(i);
+#else
+  unsigned i = 0;
+  for (unsigned s = 32; s > 0; s /= 2)
+    if (x >> s) {
+      x >>= s;
+      i += s;
+    }
+  return i;
+#endif
+}
+
+/*
+  Divides unsigned integers by a constant divisor d without a division instruction,
+  which is several times slower than a multiplication.
+
+  If d is a power of two, the quotient is a shift. Otherwise, the quotient of x is
+  computed as the high word of the 128-bit product x * m, shifted right by s, where
+  s = floor(log2(d)) and m = ceil(2^(64 + s) / d) < 2^64. With m * d = 2^(64 + s) + e and
+  e < d < 2^(s + 1), this is exact if x * e < 2^(64 + s), which holds for all x < 2^63.
+  The caller passes an upper limit for the numerators, and the division instruction is
+  used if the limit is larger, or if the compiler has no 128-bit integers.
+*/
+class fast_divider {
+#if defined(__SIZEOF_INT128__)
+  __extension__ using uint128 = unsigned __int128;
+#endif
+
+public:
+  fast_divider() = default;
+
+  // numerators must not exceed limit
+  fast_divider(std::uint64_t d, std::uint64_t limit) noexcept : d_(d) {
+    s_ = highest_bit(d);
+    if ((d & (d - 1)) == 0) return; // power of two
+#if defined(__SIZEOF_INT128__)
+    if (limit < (std::uint64_t{1} << 63))
+      m_ = static_cast<std::uint64_t>((uint128{1} << (64 + s_)) / d) + 1;
+#else
+    (void)limit;
+#endif
+  }
+
+  std::uint64_t operator()(std::uint64_t x) const noexcept {
+    // branches are always predicted correctly, since the divisor is constant
+#if defined(__SIZEOF_INT128__)
+    if (m_) return static_cast<std::uint64_t>((uint128{x} * m_) >> 64) >> s_;
+#endif
+    if ((d_ & (d_ - 1)) == 0) return x >> s_;
+    return x / d_;
+  }
+
+  std::uint64_t divisor() const noexcept { return d_; }
+
+private:
+  std::uint64_t d_ = 1, m_ = 0;
+  unsigned s_ = 0;
+};
+
+} // namespace detail
+} // namespace histogram
+} // namespace boost
+
+#endif
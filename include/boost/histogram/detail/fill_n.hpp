@@ -0,0 +1,615 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_DETAIL_FILL_N_HPP
+#define BOOST_HISTOGRAM_DETAIL_FILL_N_HPP
+
+#include <algorithm>
+#include <boost/histogram/axis/option.hpp>
+#include <boost/histogram/axis/traits.hpp>
+#include <boost/histogram/detail/axes.hpp>
+#include <boost/histogram/detail/detect.hpp>
+#include <boost/histogram/detail/linearize.hpp>
+#include <boost/histogram/detail/make_default.hpp>
+#include <boost/histogram/detail/replace_default.hpp>
+#include <boost/histogram/detail/static_if.hpp>
+#include <boost/histogram/fwd.hpp>
+#include <boost/mp11/integral.hpp>
+#include <boost/mp11/tuple.hpp>
+#include <boost/throw_exception.hpp>
+#include <boost/variant2/variant.hpp>
+#include <cmath>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace boost {
+namespace histogram {
+namespace detail {
+
+/* Batches are processed in chunks of this size. For each chunk, the linear storage
+ * indices are computed column by column, which keeps the loops over the values tight and
+ * resolves the dispatch over axis::variant once per chunk instead of once per value.
+ * Then the storage cells are incremented in a second loop. The index buffer is allocated
+ * on the stack, so the chunk size should not be too large.
+ */
+constexpr std::size_t fill_n_chunk_size = 1 << 12;
+
+// number of tasks per executor thread in fill_n_parallel
+constexpr std::size_t fill_n_tasks_per_thread = 16;
+
+// marks an element of the index buffer which does not map to a storage cell
+constexpr std::size_t invalid_index = ~static_cast<std::size_t>(0);
+
+template <class T>
+struct is_variant2 : std::false_type {};
+
+template <class... Ts>
+struct is_variant2<variant2::variant<Ts...>> : std::true_type {};
+
+template <class T>
+using is_char = mp11::mp_contains<mp11::mp_list<char, signed char, unsigned char, wchar_t,
+                                                char16_t, char32_t>,
+                                  T>;
+
+BOOST_HISTOGRAM_DETECT(has_method_data, (std::declval<const T&>().data()));
+
+BOOST_HISTOGRAM_DETECT_BINARY(has_method_index_n,
+                              (std::declval<const T&>().index_n(
+                                  std::declval<const U*>(),
+                                  std::declval<axis::index_type*>(), std::size_t{})));
+
+template <class T, bool = (has_method_data<T>::value && has_method_size<T>::value)>
+struct is_column_impl : std::false_type {};
+
+// strings are contiguous sequences, but they are values for a category axis
+template <class T>
+struct is_column_impl<T, true>
+    : mp11::mp_not<is_char<std::decay_t<decltype(*std::declval<const T&>().data())>>> {};
+
+// a column is a contiguous sequence of values or a variant of such sequences
+template <class T>
+using is_column = mp11::mp_or<is_column_impl<T>, is_variant2<T>>;
+
+template <class F, class T>
+decltype(auto) visit_column(F&& f, const T& t) {
+  return std::forward<F>(f)(t);
+}
+
+template <class F, class... Ts>
+decltype(auto) visit_column(F&& f, const variant2::variant<Ts...>& t) {
+  return variant2::visit(std::forward<F>(f), t);
+}
+
+template <class T>
+std::size_t column_size(const T& t) {
+  return visit_column([](const auto& c) { return static_cast<std::size_t>(c.size()); },
+                      t);
+}
+
+// like linearize for optional_index, but the index may be arbitrarily out of range
+template <class HasUnderflow, class HasOverflow>
+void linearize(HasUnderflow, HasOverflow, std::size_t& out, const std::size_t stride,
+               const axis::index_type size, const axis::index_type i) noexcept {
+  if (out == invalid_index) return;
+  if ((HasUnderflow::value || i >= 0) && (HasOverflow::value || i < size))
+    out += static_cast<std::size_t>(i + (HasUnderflow::value ? 1 : 0)) * stride;
+  else
+    out = invalid_index;
+}
+
+template <class Axis, class T>
+void fill_n_indices_column_static(std::false_type, std::size_t* out, const std::size_t n,
+                                  const std::size_t stride, const Axis& a, const T* x) {
+  using O = axis::traits::static_options<Axis>;
+  const auto size = a.size();
+  for (const auto end = out + n; out != end; ++out, ++x)
+    linearize(O::test(axis::option::underflow), O::test(axis::option::overflow), *out,
+              stride, size, axis::traits::index(a, *x));
+}
+
+// axis computes indices for many values at once
+template <class Axis, class T>
+void fill_n_indices_column_static(std::true_type, std::size_t* out, const std::size_t n,
+                                  const std::size_t stride, const Axis& a, const T* x) {
+  using O = axis::traits::static_options<Axis>;
+  axis::index_type bins[fill_n_chunk_size];
+  a.index_n(x, bins, n);
+  const auto size = a.size();
+  for (auto bit = bins, bend = bins + n; bit != bend; ++bit, ++out)
+    linearize(O::test(axis::option::underflow), O::test(axis::option::overflow), *out,
+              stride, size, *bit);
+}
+
+// axis cannot grow
+template <class Axis, class T>
+void fill_n_indices_column(std::false_type, std::size_t* out, const std::size_t n,
+                           const std::size_t stride, Axis& a, const T* x,
+                           axis::index_type&) {
+  fill_n_indices_column_static(has_method_index_n<Axis, T>{}, out, n, stride, a, x);
+}
+
+// axis may grow
+template <class Axis, class T>
+void fill_n_indices_column(std::true_type, std::size_t* out, const std::size_t n,
+                           const std::size_t stride, Axis& a, const T* x,
+                           axis::index_type& shift) {
+  using O = axis::traits::static_options<Axis>;
+  // Axis indices are buffered until the whole column is processed, because the axis may
+  // grow in the meantime. The index of the overflow bin changes when the axis grows, so
+  // it is stored as a sentinel. Values which fall outside of the axis and which have no
+  // underflow or overflow bin are also marked immediately, because their bin may become
+  // valid after the axis has grown.
+  constexpr auto overflow_bin = std::numeric_limits<axis::index_type>::max();
+  constexpr auto invalid_bin = std::numeric_limits<axis::index_type>::min();
+  axis::index_type bins[fill_n_chunk_size];
+  const auto bend = bins + n;
+  for (auto bit = bins; bit != bend; ++bit, ++x) {
+    axis::index_type i, s;
+    std::tie(i, s) = axis::traits::update(a, *x);
+    if (s > 0) {
+      // axis has grown at the lower end, shift bins of previous values
+      for (auto it = bins; it != bit; ++it)
+        if (*it >= 0 && *it != overflow_bin) *it += s;
+      shift += s;
+    }
+    if (i < 0)
+      *bit = O::test(axis::option::underflow) ? -1 : invalid_bin;
+    else if (i >= a.size())
+      *bit = O::test(axis::option::overflow) ? overflow_bin : invalid_bin;
+    else
+      *bit = i;
+  }
+  const auto size = a.size();
+  for (auto bit = bins; bit != bend; ++bit, ++out) {
+    if (*bit == invalid_bin)
+      *out = invalid_index;
+    else
+      linearize(O::test(axis::option::underflow), O::test(axis::option::overflow), *out,
+                stride, size, *bit == overflow_bin ? size : *bit);
+  }
+}
+
+// computes indices without changing the axes, growing axes are treated like normal axes
+template <class A, class ColumnIterator>
+void linearize_n(std::size_t* indices, const std::size_t offset, const std::size_t n,
+                 const A& axes, ColumnIterator cit) {
+  std::fill(indices, indices + n, 0);
+  std::size_t stride = 1;
+  for_each_axis(axes, [&](const auto& a) {
+    using Axis = std::decay_t<decltype(a)>;
+    visit_column(
+        [&](const auto& c) {
+          using T = std::decay_t<decltype(*c.data())>;
+          fill_n_indices_column_static(has_method_index_n<Axis, T>{}, indices, n, stride,
+                                       a, c.data() + offset);
+        },
+        *cit++);
+    stride *= static_cast<std::size_t>(axis::traits::extent(a));
+  });
+}
+
+// histogram has no growing axis
+template <class A, class S, class ColumnIterator>
+void fill_n_indices(std::false_type, std::size_t* indices, const std::size_t offset,
+                    const std::size_t n, A& axes, S&, ColumnIterator cit) {
+  linearize_n(indices, offset, n, axes, cit);
+}
+
+// histogram has growing axis
+template <class A, class S, class ColumnIterator>
+void fill_n_indices(std::true_type, std::size_t* indices, const std::size_t offset,
+                    const std::size_t n, A& axes, S& storage, ColumnIterator cit) {
+  axis::index_type extents[buffer_size<A>::value];
+  axis::index_type shifts[buffer_size<A>::value];
+  growth_guard<A> guard{axes};
+  std::fill(indices, indices + n, 0);
+  auto eit = extents;
+  auto sit = shifts;
+  bool update_needed = false;
+  std::size_t stride = 1;
+  for_each_axis(axes, [&](auto& a) {
+    using Axis = std::decay_t<decltype(a)>;
+    *eit = axis::traits::extent(a);
+    *sit = 0;
+    visit_column(
+        [&](const auto& c) {
+          fill_n_indices_column(is_growing<Axis>{}, indices, n, stride, a,
+                                c.data() + offset, *sit);
+        },
+        *cit++);
+    const auto e = axis::traits::extent(a);
+    update_needed |= (e != *eit);
+    stride *= static_cast<std::size_t>(e);
+    ++eit;
+    ++sit;
+  });
+  if (update_needed) {
+    guard.check();
+    grow_storage(axes, storage, extents, shifts);
+  }
+}
+
+template <class T>
+bool fill_n_isfinite(std::true_type, const T& x) noexcept {
+  return std::isfinite(x);
+}
+
+template <class T>
+bool fill_n_isfinite(std::false_type, const T&) noexcept {
+  return true;
+}
+
+// generic growing axis, returns the number of bins added at the lower end
+template <class Axis, class T>
+axis::index_type fill_n_grow_axis(std::true_type, Axis& a, const T* x,
+                                  const std::size_t n) {
+  axis::index_type shift = 0;
+  for (const auto end = x + n; x != end; ++x)
+    shift += std::max(axis::traits::update(a, *x).second, 0);
+  return shift;
+}
+
+template <class Axis, class T>
+axis::index_type fill_n_grow_axis(std::false_type, Axis&, const T*, const std::size_t) {
+  return 0;
+}
+
+// for these axes, only the smallest and largest finite value can cause growth
+template <class Axis, class T>
+axis::index_type fill_n_grow_axis_minmax(Axis& a, const T* x, const std::size_t n) {
+  auto lo = std::numeric_limits<T>::max();
+  auto hi = std::numeric_limits<T>::lowest();
+  for (const auto end = x + n; x != end; ++x) {
+    if (!fill_n_isfinite(std::is_floating_point<T>{}, *x)) continue;
+    lo = *x < lo ? *x : lo;
+    hi = hi < *x ? *x : hi;
+  }
+  if (hi < lo) return 0;
+  const auto shift = std::max(axis::traits::update(a, lo).second, 0);
+  axis::traits::update(a, hi);
+  return shift;
+}
+
+template <class V, class Tr, class M, class O, class T,
+          class = std::enable_if_t<
+              std::is_arithmetic<T>::value &&
+              std::is_same<replace_default<Tr, axis::transform::id>,
+                           axis::transform::id>::value>>
+axis::index_type fill_n_grow_axis(std::true_type, axis::regular<V, Tr, M, O>& a,
+                                  const T* x, const std::size_t n) {
+  return fill_n_grow_axis_minmax(a, x, n);
+}
+
+template <class V, class M, class O, class T,
+          class = std::enable_if_t<std::is_arithmetic<T>::value>>
+axis::index_type fill_n_grow_axis(std::true_type, axis::integer<V, M, O>& a, const T* x,
+                                  const std::size_t n) {
+  return fill_n_grow_axis_minmax(a, x, n);
+}
+
+/* Grows all axes to their final extent for the whole batch before any cell is filled and
+ * then grows the storage only once. Otherwise, a batch which drifts out of the axis range
+ * would reallocate and copy the storage once per chunk. If the axes would grow beyond
+ * BOOST_HISTOGRAM_GROWTH_LIMIT, nothing of the batch is filled.
+ */
+template <class A, class S, class ColumnIterator>
+void fill_n_grow(std::true_type, A& axes, S& storage, ColumnIterator cit,
+                 const std::size_t n) {
+  axis::index_type extents[buffer_size<A>::value];
+  axis::index_type shifts[buffer_size<A>::value];
+  growth_guard<A> guard{axes};
+  auto eit = extents;
+  auto sit = shifts;
+  bool update_needed = false;
+  for_each_axis(axes, [&](auto& a) {
+    using Axis = std::decay_t<decltype(a)>;
+    *eit = axis::traits::extent(a);
+    visit_column(
+        [&](const auto& c) {
+          *sit = fill_n_grow_axis(is_growing<Axis>{}, a, c.data(), n);
+        },
+        *cit++);
+    update_needed |= (axis::traits::extent(a) != *eit);
+    ++eit;
+    ++sit;
+  });
+  if (update_needed) {
+    guard.check();
+    grow_storage(axes, storage, extents, shifts);
+  }
+}
+
+template <class A, class S, class ColumnIterator>
+void fill_n_grow(std::false_type, A&, S&, ColumnIterator, const std::size_t) {}
+
+template <class T>
+std::size_t fill_n_size(const weight_type<T>& w) {
+  return static_cast<std::size_t>(w.value.size());
+}
+
+template <class... Ts>
+std::size_t fill_n_size(const sample_type<std::tuple<Ts...>>& s) {
+  std::size_t n = 0;
+  bool equal = true;
+  mp11::tuple_for_each(s.value, [&n, &equal](const auto& x) {
+    const auto m = static_cast<std::size_t>(x.size());
+    equal &= (n == 0 || n == m);
+    n = m;
+  });
+  if (!equal)
+    BOOST_THROW_EXCEPTION(std::invalid_argument("sample columns must have equal size"));
+  return n;
+}
+
+// replace the sequences of weights and samples by pointers to their first element
+template <class T>
+auto fill_n_data(const weight_type<T>& w) noexcept {
+  using P = decltype(w.value.data());
+  return weight_type<P>{w.value.data()};
+}
+
+template <class... Ts>
+auto fill_n_data(const sample_type<std::tuple<Ts...>>& s) noexcept {
+  using P = std::tuple<decltype(std::declval<const std::decay_t<Ts>&>().data())...>;
+  return sample_type<P>{
+      mp11::tuple_apply([](const auto&... xs) { return P{xs.data()...}; }, s.value)};
+}
+
+template <class B, class T>
+void fill_n_cell(B, T&& t, std::size_t) {
+  fill_impl(mp11::mp_int<-1>{}, mp11::mp_int<-1>{}, B{}, std::forward<T>(t),
+            std::tuple<>{});
+}
+
+template <class T, class W>
+void fill_n_cell(std::true_type, T&& t, std::size_t i, const weight_type<W*>& w) {
+  t += w.value[i];
+}
+
+template <class T, class W>
+void fill_n_cell(std::false_type, T&& t, std::size_t i, const weight_type<W*>& w) {
+  t(w.value[i]);
+}
+
+template <class B, class T, class... Ps>
+void fill_n_cell(B, T&& t, std::size_t i, const sample_type<std::tuple<Ps...>>& s) {
+  mp11::tuple_apply([&t, i](auto... ps) { t(ps[i]...); }, s.value);
+}
+
+template <class B, class T, class W, class... Ps>
+void fill_n_cell(B, T&& t, std::size_t i, const weight_type<W*>& w,
+                 const sample_type<std::tuple<Ps...>>& s) {
+  mp11::tuple_apply([&t, &w, i](auto... ps) { t(w.value[i], ps[i]...); }, s.value);
+}
+
+// second phase: increment the storage cells, skipping invalid indices
+template <class S, class Iterator, class... Us>
+void fill_n_storage(S&& storage, Iterator it, const std::size_t n,
+                    const std::size_t offset, const Us&... us) {
+  using B = has_operator_preincrement<typename std::decay_t<S>::value_type>;
+  for (std::size_t i = 0; i < n; ++i, ++it)
+    if (*it != invalid_index) fill_n_cell(B{}, storage[*it], offset + i, us...);
+}
+
+// fills the values in [first, last) of the batch
+template <class A, class S, class ColumnIterator, class... Us>
+void fill_n_range(A& axes, S& storage, const ColumnIterator columns,
+                  const std::size_t first, const std::size_t last, const Us&... us) {
+  std::size_t indices[fill_n_chunk_size];
+  for (std::size_t offset = first; offset < last; offset += fill_n_chunk_size) {
+    const auto m = std::min(fill_n_chunk_size, last - offset);
+    // axes may still grow by a bin here due to round-off in the prescan
+    fill_n_indices(has_growing_axis<A>{}, indices, offset, m, axes, storage, columns);
+    // storage may be replaced by growth in fill_n_indices
+    fill_n_storage(local_storage(storage), indices, m, offset, us...);
+  }
+}
+
+template <class A, class S, class ColumnIterator, class... Us>
+void fill_n_scatter(A& axes, S& storage, const ColumnIterator columns,
+                    const std::size_t n, const Us&... us) {
+  fill_n_grow(has_growing_axis<A>{}, axes, storage, columns, n);
+  fill_n_range(axes, storage, columns, 0, n, us...);
+}
+
+// calls f with an iterator to the first column and the number of columns
+template <class Iterable, class F>
+void visit_columns(const Iterable& args, F&& f) {
+  using std::begin;
+  using std::end;
+  using T = std::decay_t<decltype(*begin(args))>;
+  static_if<is_column<T>>(
+      [&f](const auto& args) {
+        f(begin(args), static_cast<unsigned>(std::distance(begin(args), end(args))));
+      },
+      // args is a single column of values
+      [&f](const auto& args) { f(&args, 1u); }, args);
+}
+
+// returns the size of the columns, weights and samples must have the same size
+template <class A, class ColumnIterator, class... Us>
+std::size_t fill_n_check(const A& axes, ColumnIterator cit, const unsigned ncolumns,
+                         const Us&... us) {
+  if (axes_rank(axes) != ncolumns)
+    BOOST_THROW_EXCEPTION(std::invalid_argument("number of arguments != histogram rank"));
+  const std::size_t n = column_size(*cit);
+  for (unsigned i = 0; i < ncolumns; ++i)
+    if (column_size(*cit++) != n)
+      BOOST_THROW_EXCEPTION(std::invalid_argument("columns must have equal size"));
+  for (auto&& m : {n, fill_n_size(us)...})
+    if (m != n)
+      BOOST_THROW_EXCEPTION(
+          std::invalid_argument("weights and samples must have the size of columns"));
+  return n;
+}
+
+/* Fill storage with a batch of values. Args is an iterable of columns, or a single
+ * column if the histogram is one-dimensional. The optional weights and samples must be
+ * passed as weight_type and sample_type in this order, wrapping sequences of the same
+ * size as the columns.
+ */
+template <class A, class S, class Iterable, class... Us>
+void fill_n(A& axes, S& storage, const Iterable& args, const Us&... us) {
+  visit_columns(args, [&](auto columns, const unsigned ncolumns) {
+    const auto n = fill_n_check(axes, columns, ncolumns, us...);
+    fill_n_scatter(axes, storage, columns, n, fill_n_data(us)...);
+  });
+}
+
+// adds the cells of storage b to the cells of storage a
+template <class S>
+void fill_n_add(S& a, const S& b) {
+  auto it = a.begin();
+  for (auto&& x : b) *it++ += x;
+}
+
+// storage which keeps a copy for each thread: every task fills the copy of its thread
+template <class Executor, class A, class S, class ColumnIterator, class... Us>
+void fill_n_parallel_impl(std::true_type, Executor& ex, const std::size_t ntasks, A& axes,
+                          S& storage, const ColumnIterator columns, const std::size_t n,
+                          const Us&... us) {
+  ex.run(ntasks, [&](std::size_t k, std::size_t) {
+    fill_n_range(axes, storage, columns, k * n / ntasks, (k + 1) * n / ntasks, us...);
+  });
+}
+
+/* Other storages: each thread of the executor fills its own partial storage, thread 0
+ * fills the target storage. The partials are then added pairwise in a tree of depth
+ * log2(threads). Each addition reads and writes whole storages, so that a cell is never
+ * accessed by two threads at the same time. This is required for storages like
+ * unlimited_storage, whose cells are not independent. Threads which did not take a task
+ * leave their partial empty, it is skipped in the additions.
+ */
+template <class Executor, class A, class S, class ColumnIterator, class... Us>
+void fill_n_parallel_impl(std::false_type, Executor& ex, const std::size_t ntasks,
+                          A& axes, S& storage, const ColumnIterator columns,
+                          const std::size_t n, const Us&... us) {
+  const auto nthreads = static_cast<std::size_t>(ex.size());
+  std::vector<S> partials(nthreads - 1, make_default(storage));
+  std::vector<char> used(nthreads, 0);
+  used[0] = 1;
+  const auto size = storage.size();
+  ex.run(ntasks, [&](std::size_t k, std::size_t t) {
+    if (!(t < nthreads))
+      BOOST_THROW_EXCEPTION(std::out_of_range("thread index of executor out of range"));
+    auto& s = t == 0 ? storage : partials[t - 1];
+    // partial storages are allocated and zeroed by the thread which fills them
+    if (!used[t]) {
+      s.reset(size);
+      used[t] = 1;
+    }
+    fill_n_range(axes, s, columns, k * n / ntasks, (k + 1) * n / ntasks, us...);
+  });
+  for (std::size_t step = 1; step < nthreads; step *= 2) {
+    ex.run((nthreads - 1) / (2 * step) + 1, [&](std::size_t k, std::size_t) {
+      const auto i = 2 * step * k;
+      const auto j = i + step;
+      if (!(j < nthreads) || !used[j]) return;
+      // i > 0 here, since the target storage is always used
+      if (!used[i])
+        std::swap(partials[i - 1], partials[j - 1]);
+      else
+        fill_n_add(i == 0 ? storage : partials[i - 1], partials[j - 1]);
+      used[i] = 1;
+    });
+  }
+}
+
+// histogram has growing axis, fill serially
+template <class Executor, class A, class S, class ColumnIterator, class... Us>
+void fill_n_parallel(std::true_type, Executor&, A& axes, S& storage,
+                     const ColumnIterator columns, const std::size_t n, const Us&... us) {
+  fill_n_scatter(axes, storage, columns, n, us...);
+}
+
+// histogram has no growing axis
+template <class Executor, class A, class S, class ColumnIterator, class... Us>
+void fill_n_parallel(std::false_type, Executor& ex, A& axes, S& storage,
+                     const ColumnIterator columns, const std::size_t n, const Us&... us) {
+  const auto nthreads = static_cast<std::size_t>(ex.size());
+  // Many more tasks than threads, so that threads which are slow or preempted do not
+  // stall the fill, while the overhead per task stays small. Each task gets at least
+  // one chunk.
+  const auto nchunks = (n + fill_n_chunk_size - 1) / fill_n_chunk_size;
+  const auto ntasks = std::min(fill_n_tasks_per_thread * nthreads, nchunks);
+  if (nthreads < 2 || ntasks < 2)
+    fill_n_scatter(axes, storage, columns, n, us...);
+  else
+    fill_n_parallel_impl(has_method_shard<S>{}, ex, ntasks, axes, storage, columns, n,
+                         us...);
+}
+
+/* Like fill_n, but the batch is split into parts which are filled by the threads of the
+ * executor. Growing axes cannot be changed concurrently, a histogram with growing axes is
+ * filled serially.
+ */
+template <class Executor, class A, class S, class Iterable, class... Us>
+void fill_n_parallel(Executor& ex, A& axes, S& storage, const Iterable& args,
+                     const Us&... us) {
+  visit_columns(args, [&](auto columns, const unsigned ncolumns) {
+    const auto n = fill_n_check(axes, columns, ncolumns, us...);
+    fill_n_parallel(has_growing_axis<A>{}, ex, axes, storage, columns, n,
+                    fill_n_data(us)...);
+  });
+}
+
+template <class Executor, class A, class S, class Iterable, class T, class U>
+void fill_n_parallel(Executor& ex, A& axes, S& storage, const Iterable& args,
+                     const sample_type<T>& samples, const weight_type<U>& weights) {
+  fill_n_parallel(ex, axes, storage, args, weights, samples);
+}
+
+// first phase of fill_n on its own, writes linear indices to out
+template <class A, class Iterable, class OutputIterator>
+OutputIterator linearize_columns(const A& axes, const Iterable& args,
+                                 OutputIterator out) {
+  visit_columns(args, [&](auto columns, const unsigned ncolumns) {
+    const auto n = fill_n_check(axes, columns, ncolumns);
+    std::size_t indices[fill_n_chunk_size];
+    for (std::size_t offset = 0; offset < n; offset += fill_n_chunk_size) {
+      const auto m = std::min(fill_n_chunk_size, n - offset);
+      linearize_n(indices, offset, m, axes, columns);
+      out = std::copy(indices, indices + m, out);
+    }
+  });
+  return out;
+}
+
+// second phase of fill_n on its own, for indices computed with linearize_columns
+template <class S, class Iterable, class... Us>
+void fill_linearized(S& storage, const Iterable& indices, const Us&... us) {
+  using std::begin;
+  using std::end;
+  const auto n = static_cast<std::size_t>(std::distance(begin(indices), end(indices)));
+  for (auto&& m : {n, fill_n_size(us)...})
+    if (m != n)
+      BOOST_THROW_EXCEPTION(
+          std::invalid_argument("weights and samples must have the size of indices"));
+  const auto size = static_cast<std::size_t>(storage.size());
+  for (auto&& i : indices)
+    if (i != invalid_index && !(i < size))
+      BOOST_THROW_EXCEPTION(std::out_of_range("index out of bounds"));
+  fill_n_storage(local_storage(storage), begin(indices), n, 0, fill_n_data(us)...);
+}
+
+template <class S, class Iterable, class T, class U>
+void fill_linearized(S& storage, const Iterable& indices, const sample_type<T>& samples,
+                     const weight_type<U>& weights) {
+  fill_linearized(storage, indices, weights, samples);
+}
+
+} // namespace detail
+} // namespace histogram
+} // namespace boost
+
+#endif
@@ -0,0 +1,61 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_DETAIL_GALLOP_HPP
+#define BOOST_HISTOGRAM_DETAIL_GALLOP_HPP
+
+#include <algorithm>
+#include <cstddef>
+
+namespace boost {
+namespace histogram {
+namespace detail {
+
+/*
+  Finds the position returned by std::upper_bound in the sorted sequence v[0, n),
+  starting at the guess k in [0, n]. The search gallops outward from k with steps of 1,
+  2, 4, ... until the position is bracketed, and then searches the bracket. This takes
+  O(log d) comparisons, where d is the distance of the position from k, so it is O(1)
+  for a good guess. To bound the cost of a bad guess, the search gives up after
+  max_steps steps and returns n + 1.
+*/
+template <class T>
+std::size_t gallop_upper_bound(const T* v, const std::size_t n, const T& x,
+                               const std::size_t k,
+                               const unsigned max_steps = 4) noexcept {
+  if (k > 0 && x < v[k - 1]) {
+    // position is at most hi
+    std::size_t hi = k - 1, step = 1;
+    for (unsigned s = 0; s < max_steps; ++s, step *= 2) {
+      if (hi < step) return static_cast<std::size_t>(std::upper_bound(v, v + hi, x) - v);
+      const auto j = hi - step;
+      if (!(x < v[j]))
+        return static_cast<std::size_t>(std::upper_bound(v + j + 1, v + hi, x) - v);
+      hi = j;
+    }
+    return n + 1;
+  }
+  // NaN is not less than any value, like for std::upper_bound
+  if (k < n && !(x < v[k])) {
+    // position is at least lo
+    std::size_t lo = k + 1, step = 1;
+    for (unsigned s = 0; s < max_steps; ++s, step *= 2) {
+      if (n - lo < step)
+        return static_cast<std::size_t>(std::upper_bound(v + lo, v + n, x) - v);
+      const auto j = lo + step - 1;
+      if (x < v[j]) return static_cast<std::size_t>(std::upper_bound(v + lo, v + j, x) - v);
+      lo = j + 1;
+    }
+    return n + 1;
+  }
+  return k;
+}
+
+} // namespace detail
+} // namespace histogram
+} // namespace boost
+
+#endif
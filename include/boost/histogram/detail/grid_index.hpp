@@ -0,0 +1,138 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_DETAIL_GRID_INDEX_HPP
+#define BOOST_HISTOGRAM_DETAIL_GRID_INDEX_HPP
+
+#include <algorithm>
+#include <boost/histogram/fwd.hpp>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace boost {
+namespace histogram {
+namespace detail {
+
+/*
+  Regular grid over the range of a sorted sequence, which finds the same position as
+  std::upper_bound in constant time if the values are roughly equidistant.
+
+  The cell of an argument is computed like the bin of a regular axis. The computation is
+  monotonic, also with round-off, so the values in cells before the cell of the
+  argument are smaller than the argument and the values in cells after it are larger.
+  Each cell stores the number of values in the cells before it, and a lookup only
+  compares the argument with the values in its cell. This is done with a fixed number
+  of steps without branches, since mispredicted branches would cost more than a few
+  extra comparisons. Values beyond the grid and NaN use an extra cell at the end.
+
+  The grid is only built if it is worth it: the number of cells is doubled up to
+  max_cells_per_value times the number of values, until each cell has at most one
+  value. The smallest grid with the fewest values per cell is used, if that number is
+  at most max_steps. Otherwise, the index stays empty.
+
+  Cells of integral values are computed in double precision. The conversion is monotonic,
+  so the lookup is still exact, since it compares the integral values.
+*/
+template <class Allocator>
+class grid_index {
+  using value_type = typename std::allocator_traits<Allocator>::value_type;
+  using real_type = std::conditional_t<std::is_floating_point<value_type>::value,
+                                       value_type, double>;
+  using cell_allocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<axis::index_type>;
+
+  static constexpr std::size_t max_cells_per_value = 8;
+  static constexpr std::size_t max_steps = 3;
+
+public:
+  explicit grid_index(const Allocator& a = {}) : cells_(cell_allocator(a)) {}
+
+  bool empty() const noexcept { return cells_.empty(); }
+
+  // returns number of values in v which are not greater than x, v.size() for NaN
+  template <class Vector>
+  std::size_t find(const Vector& v, const value_type x) const noexcept {
+    const std::size_t n = v.size();
+    std::size_t k = static_cast<std::size_t>(cells_[cell(x)]);
+    for (unsigned s = steps_; s > 0; --s)
+      k += static_cast<std::size_t>(k < n) & !(x < v[std::min(k, n - 1)]);
+    return k;
+  }
+
+  // index is only built if v has at least min_size values
+  template <class Vector>
+  void rebuild(const Vector& v, std::size_t min_size) {
+    cells_.clear();
+    if (v.size() < std::max<std::size_t>(min_size, 2)) return;
+    const real_type a = v.front();
+    const real_type b = v.back();
+    if (!std::isfinite(a) || !std::isfinite(b) || !std::isfinite(b - a)) return;
+    // use the smallest grid with the fewest steps
+    const std::size_t n = v.size() - 1;
+    std::size_t m = n, best_m = 0, best_steps = max_steps + 1;
+    for (; m <= max_cells_per_value * n && best_steps > 1; m *= 2) {
+      const auto steps = build(v, m);
+      if (steps < best_steps) {
+        best_m = m;
+        best_steps = steps;
+      }
+    }
+    if (best_steps > max_steps)
+      cells_.clear();
+    else if (best_m != m / 2) // last grid is not the best one
+      build(v, best_m);
+  }
+
+private:
+  // index of cell, last cell for values beyond the grid and NaN
+  std::size_t cell(const value_type x) const noexcept {
+    const real_type z = (static_cast<real_type>(x) - min_) * scale_;
+    return z < last_ ? (z > 0 ? static_cast<std::size_t>(z) : 0) : cells_.size() - 1;
+  }
+
+  // returns the maximum number of values per cell, or max_steps + 1 on failure
+  template <class Vector>
+  std::size_t build(const Vector& v, std::size_t m) {
+    steps_ = max_steps + 1;
+    min_ = v.front();
+    scale_ = static_cast<real_type>(m) / (static_cast<real_type>(v.back()) - min_);
+    if (!std::isfinite(scale_)) return steps_;
+    last_ = static_cast<real_type>(m);
+    cells_.assign(m + 1, 0);
+    // count values per cell, then accumulate the counts of the preceding cells
+    std::size_t steps = 0;
+    for (std::size_t k = 0; k < v.size();) {
+      const auto c = cell(v[k]);
+      std::size_t j = k + 1;
+      while (j < v.size() && cell(v[j]) == c) ++j;
+      steps = std::max(steps, j - k);
+      if (steps > max_steps) return steps_;
+      cells_[c] = static_cast<axis::index_type>(j - k);
+      k = j;
+    }
+    axis::index_type sum = 0;
+    for (auto&& c : cells_) {
+      const auto count = c;
+      c = sum;
+      sum += count;
+    }
+    steps_ = static_cast<unsigned>(steps);
+    return steps;
+  }
+
+  std::vector<axis::index_type, cell_allocator> cells_;
+  real_type min_ = 0, scale_ = 0, last_ = 0;
+  unsigned steps_ = 0;
+};
+
+} // namespace detail
+} // namespace histogram
+} // namespace boost
+
+#endif
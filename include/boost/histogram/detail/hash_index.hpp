@@ -0,0 +1,218 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_DETAIL_HASH_INDEX_HPP
+#define BOOST_HISTOGRAM_DETAIL_HASH_INDEX_HPP
+
+#include <boost/histogram/detail/detect.hpp>
+#include <boost/histogram/fwd.hpp>
+#include <boost/mp11/function.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+#if __cpp_lib_string_view >= 201606
+#include <string_view>
+#endif
+
+namespace boost {
+namespace histogram {
+namespace detail {
+
+BOOST_HISTOGRAM_DETECT(is_hashable, (std::hash<T>{}(std::declval<const T&>())));
+
+// 64 bit mix function of MurmurHash3
+inline std::size_t mix_hash(std::uint64_t h) noexcept {
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  return static_cast<std::size_t>(h);
+}
+
+// characters of a string which is not owned
+template <class C, class T>
+struct char_view {
+  const C* data;
+  std::size_t size;
+};
+
+template <class C, class T, class A>
+bool operator==(const std::basic_string<C, T, A>& a, const char_view<C, T>& b) noexcept {
+  return a.size() == b.size && T::compare(a.data(), b.data, b.size) == 0;
+}
+
+// converts an argument for lookup among values of type Value without conversion to
+// Value; by default, there are no such arguments
+template <class Value>
+struct lookup_key {};
+
+// strings can be looked up with pointers to null-terminated strings, string views, or
+// strings with another allocator
+template <class C, class T, class A>
+struct lookup_key<std::basic_string<C, T, A>> {
+  template <class A2>
+  static char_view<C, T> make(const std::basic_string<C, T, A2>& x) noexcept {
+    return {x.data(), x.size()};
+  }
+
+#if __cpp_lib_string_view >= 201606
+  static char_view<C, T> make(std::basic_string_view<C, T> x) noexcept {
+    return {x.data(), x.size()};
+  }
+#endif
+
+  static char_view<C, T> make(const C* x) noexcept { return {x, T::length(x)}; }
+};
+
+BOOST_HISTOGRAM_DETECT_BINARY(has_lookup_key,
+                              (lookup_key<T>::make(std::declval<const U&>())));
+
+// U can be looked up among values of type Value without conversion
+template <class Value, class U>
+using is_transparent_key =
+    mp11::mp_and<mp11::mp_not<std::is_same<std::decay_t<U>, Value>>,
+                 has_lookup_key<Value, U>>;
+
+template <class Value>
+struct key_hash {
+  // std::hash is the identity for integers in common implementations, the bits are
+  // mixed so that regular patterns like multiples of a power of 2 do not cluster
+  template <class U, class = std::enable_if_t<std::is_same<U, Value>::value &&
+                                              is_hashable<U>::value>>
+  std::size_t operator()(const U& x) const noexcept {
+    return mix_hash(std::hash<Value>{}(x));
+  }
+};
+
+// strings are hashed by their characters, so that lookup keys have the same hash
+template <class C, class T, class A>
+struct key_hash<std::basic_string<C, T, A>> {
+  std::size_t operator()(const std::basic_string<C, T, A>& x) const noexcept {
+    return chars(x.data(), x.size());
+  }
+
+  std::size_t operator()(const char_view<C, T>& x) const noexcept {
+    return chars(x.data, x.size);
+  }
+
+  // processes eight bytes at a time
+  static std::size_t chars(const C* x, std::size_t n) noexcept {
+    const auto p = reinterpret_cast<const unsigned char*>(x);
+    n *= sizeof(C);
+    std::uint64_t h = 0x9e3779b97f4a7c15ULL ^ n;
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+      std::uint64_t k;
+      std::memcpy(&k, p + i, 8);
+      h = (h ^ k) * 0xff51afd7ed558ccdULL;
+      h ^= h >> 32;
+    }
+    if (i < n) {
+      std::uint64_t k = 0;
+      for (unsigned shift = 0; i < n; ++i, shift += 8) k |= std::uint64_t{p[i]} << shift;
+      h = (h ^ k) * 0xff51afd7ed558ccdULL;
+    }
+    return mix_hash(h);
+  }
+};
+
+BOOST_HISTOGRAM_DETECT_BINARY(is_hashable_with,
+                              (key_hash<T>{}(std::declval<const U&>())));
+
+/*
+  Open-addressing hash table which maps values to their position in a separate vector of
+  unique values. Values can be looked up with any key for which key_hash of the value type
+  is defined. The table only stores positions, so it does not duplicate the values
+  and stays valid when the vector is copied or moved. Slots hold the position plus one,
+  zero marks an empty slot. Collisions are resolved by linear probing; the table is kept
+  at most half full, so probe sequences are short.
+*/
+template <class Allocator>
+class hash_index {
+  using hash_type = key_hash<typename std::allocator_traits<Allocator>::value_type>;
+  using slot_allocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<axis::index_type>;
+
+public:
+  explicit hash_index(const Allocator& a = {}) : slots_(slot_allocator(a)) {}
+
+  bool empty() const noexcept { return slots_.empty(); }
+
+  // returns v.size() if x is not found
+  template <class Vector, class U>
+  axis::index_type find(const Vector& v, const U& x) const noexcept {
+    const std::size_t mask = slots_.size() - 1;
+    for (std::size_t k = hash_type{}(x);; ++k) {
+      const axis::index_type s = slots_[k & mask];
+      if (s == 0) return static_cast<axis::index_type>(v.size());
+      if (v[s - 1] == x) return s - 1;
+    }
+  }
+
+  // index is only built if v has at least min_size values
+  template <class Vector>
+  void rebuild(const Vector& v, std::size_t min_size) {
+    if (v.size() < min_size)
+      slots_.clear();
+    else
+      build(v);
+  }
+
+  // must be called after a new value was appended to v
+  template <class Vector>
+  void push_back(const Vector& v, std::size_t min_size) {
+    if (slots_.empty())
+      rebuild(v, min_size);
+    else if (2 * v.size() > slots_.size())
+      build(v);
+    else
+      insert(v, v.size() - 1);
+  }
+
+private:
+  template <class Vector>
+  void build(const Vector& v) {
+    std::size_t n = 8;
+    while (n < 2 * v.size()) n *= 2;
+    slots_.assign(n, 0);
+    for (std::size_t i = 0; i < v.size(); ++i) insert(v, i);
+  }
+
+  template <class Vector>
+  void insert(const Vector& v, std::size_t i) noexcept {
+    const std::size_t mask = slots_.size() - 1;
+    std::size_t k = hash_type{}(v[i]);
+    while (slots_[k & mask] != 0) ++k;
+    slots_[k & mask] = static_cast<axis::index_type>(i + 1);
+  }
+
+  std::vector<axis::index_type, slot_allocator> slots_;
+};
+
+// stand-in for value types which have no key_hash, the index is always empty
+template <class Allocator>
+struct no_hash_index {
+  explicit no_hash_index(const Allocator& = {}) noexcept {}
+  bool empty() const noexcept { return true; }
+  template <class Vector, class U>
+  axis::index_type find(const Vector& v, const U&) const noexcept {
+    return static_cast<axis::index_type>(v.size());
+  }
+  template <class Vector>
+  void rebuild(const Vector&, std::size_t) noexcept {}
+  template <class Vector>
+  void push_back(const Vector&, std::size_t) noexcept {}
+};
+
+} // namespace detail
+} // namespace histogram
+} // namespace boost
+
+#endif
@@ -13,21 +13,51 @@
 #include <boost/histogram/axis/variant.hpp>
 #include <boost/histogram/detail/args_type.hpp>
 #include <boost/histogram/detail/axes.hpp>
+#include <boost/histogram/detail/detect.hpp>
 #include <boost/histogram/detail/make_default.hpp>
 #include <boost/histogram/detail/static_if.hpp>
 #include <boost/histogram/detail/tuple_slice.hpp>
 #include <boost/histogram/fwd.hpp>
+#include <boost/histogram/unsafe_access.hpp>
 #include <boost/mp11/algorithm.hpp>
 #include <boost/mp11/function.hpp>
 #include <boost/mp11/integral.hpp>
 #include <boost/mp11/list.hpp>
 #include <boost/mp11/tuple.hpp>
 #include <boost/throw_exception.hpp>
+#include <cstddef>
+#include <cstdlib>
 #include <mutex>
+#include <shared_mutex>
 #include <stdexcept>
 #include <tuple>
 #include <type_traits>
 
+/* When a storage grows along the last axis, it is resized in place like std::vector, if
+ * the storage supports this. Extra capacity is then reserved in advance, so that a
+ * histogram which grows steadily does not reallocate its storage for every new bin. The
+ * extra capacity is equal to the new size, but at most this number of cells, so that
+ * a single outlier which causes a large growth does not also cause a large reservation.
+ *
+ * Capacity is only reserved at the end of the storage, so only growth at the upper end
+ * of the last axis takes amortized constant time. Growth at the lower end moves all
+ * cells up in one pass, and growth of any other axis relocates all cells into a new
+ * storage, which takes linear time in the number of cells for each growth.
+ */
+#ifndef BOOST_HISTOGRAM_DETAIL_GROWTH_RESERVE_LIMIT
+#define BOOST_HISTOGRAM_DETAIL_GROWTH_RESERVE_LIMIT (1 << 20)
+#endif
+
+/* Maximum number of cells of a histogram with growing axes. A fill which would let the
+ * axes grow beyond this number throws std::length_error and leaves the axes and the
+ * storage unchanged, so that a single outlier cannot cause a huge allocation. To restore
+ * the axes, they are copied before each fill which lets them grow, so this is disabled
+ * by default.
+ */
+#ifndef BOOST_HISTOGRAM_GROWTH_LIMIT
+#define BOOST_HISTOGRAM_GROWTH_LIMIT (~static_cast<std::size_t>(0))
+#endif
+
 namespace boost {
 namespace histogram {
 namespace detail {
@@ -61,6 +91,45 @@ using has_multidim_axis = has_special_axis<is_multidim, T>;
 template <class T>
 using has_growing_axis = has_special_axis<is_growing, T>;
 
+constexpr std::size_t growth_limit = BOOST_HISTOGRAM_GROWTH_LIMIT;
+
+// keeps a copy of the axes while they grow, to restore them if they grow too large
+template <class A, bool = (growth_limit < ~static_cast<std::size_t>(0))>
+class growth_guard {
+public:
+  static constexpr bool enabled = true;
+
+  explicit growth_guard(A& axes) : axes_(axes), backup_(axes) {}
+
+  // call after the axes have grown and before the storage grows
+  void check() {
+    std::size_t n = 1;
+    bool ok = true;
+    for_each_axis(axes_, [&n, &ok](const auto& a) {
+      const auto e = static_cast<std::size_t>(axis::traits::extent(a));
+      ok &= e == 0 || n <= growth_limit / e;
+      n *= e;
+    });
+    if (ok) return;
+    axes_ = std::move(backup_);
+    BOOST_THROW_EXCEPTION(
+        std::length_error("histogram would grow beyond BOOST_HISTOGRAM_GROWTH_LIMIT"));
+  }
+
+private:
+  A& axes_;
+  A backup_;
+};
+
+template <class A>
+class growth_guard<A, false> {
+public:
+  static constexpr bool enabled = false;
+
+  explicit growth_guard(A&) noexcept {}
+  void check() const noexcept {}
+};
+
 /// Index with an invalid state
 struct optional_index {
   std::size_t idx = 0;
@@ -131,6 +200,25 @@ axis::index_type linearize_value_growth(optional_index& o, axis::variant<Ts...>&
   return axis::visit([&o, &v](auto& a) { return linearize_value_growth(o, a, v); }, a);
 }
 
+// like linearize_value, but values which would make a growing axis grow are reported as
+// invalid, since the axis is not modified
+template <class Axis, class Value>
+void linearize_value_probe(optional_index& o, const Axis& a, const Value& v) {
+  using O = axis::traits::static_options<Axis>;
+  const auto i = axis::traits::index(a, v);
+  if (O::test(axis::option::growth) && (i < 0 || i >= a.size()))
+    o.stride = 0;
+  else
+    linearize(O::test(axis::option::underflow), O::test(axis::option::overflow), o,
+              a.size(), i);
+}
+
+template <class... Ts, class Value>
+void linearize_value_probe(optional_index& o, const axis::variant<Ts...>& a,
+                           const Value& v) {
+  axis::visit([&o, &v](const auto& a) { linearize_value_probe(o, a, v); }, a);
+}
+
 template <class A>
 void linearize_index(optional_index& out, const A& axis, const axis::index_type i) {
   // A may be axis or variant, cannot use static option detection here
@@ -141,65 +229,199 @@ void linearize_index(optional_index& out, const A& axis, const axis::index_type
   linearize(std::false_type{}, std::false_type{}, out, extent, i + shift);
 }
 
-template <class S, class A>
-void grow_storage(const A& axes, S& storage, const axis::index_type* shifts) {
+/* Calls f(old_offset, new_offset, n) for each block of n cells which stays contiguous
+ * when the cells are relocated after growth. The first axis is contiguous in the old
+ * and the new layout, so each row along the first axis is split into at most three
+ * blocks: the underflow bin, the normal bins, and the overflow bin.
+ */
+template <class A, class F>
+void grow_storage_blocks(const A& axes, const axis::index_type* extents,
+                         const axis::index_type* shifts, F&& f) {
   struct item {
-    axis::index_type idx, old_extent;
+    axis::index_type idx, old_extent, new_extent, shift;
+    bool underflow, overflow;
     std::size_t new_stride;
+
+    // maps old index to new index
+    axis::index_type operator()(axis::index_type i) const noexcept {
+      if (underflow && i == 0) return 0;
+      if (overflow && i == old_extent - 1) return new_extent - 1;
+      return i + shift;
+    }
   } data[buffer_size<A>::value];
+  const auto* eit = extents;
   const auto* sit = shifts;
   auto dit = data;
   std::size_t s = 1;
+  std::size_t old_size = 1;
   for_each_axis(axes, [&](const auto& a) {
+    const auto opt = axis::traits::options(a);
     const auto n = axis::traits::extent(a);
-    *dit++ = {0, n - std::abs(*sit++), s};
+    *dit++ = {0,
+              *eit,
+              n,
+              *sit++,
+              static_cast<bool>(opt & axis::option::underflow),
+              static_cast<bool>(opt & axis::option::overflow),
+              s};
     s *= n;
+    old_size *= static_cast<std::size_t>(*eit++);
   });
+  if (old_size == 0) return;
+
+  struct block {
+    std::size_t old_begin, new_begin, size;
+  } blocks[3];
+  auto bend = blocks;
+  const auto& d0 = data[0];
+  for (axis::index_type i = 0; i < d0.old_extent; ++i) {
+    const auto j = static_cast<std::size_t>(d0(i));
+    if (bend != blocks && (bend - 1)->new_begin + (bend - 1)->size == j)
+      ++(bend - 1)->size;
+    else
+      *bend++ = {static_cast<std::size_t>(i), j, 1};
+  }
+
+  const auto row = static_cast<std::size_t>(d0.old_extent);
+  const auto dfirst = data + 1;
+  const auto dlast = data + axes_rank(axes);
+  for (std::size_t old_offset = 0; old_offset < old_size; old_offset += row) {
+    std::size_t new_offset = 0;
+    for (dit = dfirst; dit != dlast; ++dit)
+      new_offset += static_cast<std::size_t>((*dit)(dit->idx)) * dit->new_stride;
+    for (auto bit = blocks; bit != bend; ++bit)
+      f(old_offset + bit->old_begin, new_offset + bit->new_begin, bit->size);
+    // advance multi-dimensional index of the rows
+    for (dit = dfirst; dit != dlast && ++dit->idx == dit->old_extent; ++dit) dit->idx = 0;
+  }
+}
+
+// relocates all cells into a new storage, whole blocks are moved at once
+template <class S, class A>
+void grow_storage_copy(const A& axes, S& storage, const axis::index_type* extents,
+                       const axis::index_type* shifts) {
   auto new_storage = make_default(storage);
   new_storage.reset(bincount(axes));
-  const auto dlast = data + axes_rank(axes) - 1;
-  for (const auto& x : storage) {
-    auto ns = new_storage.begin();
-    sit = shifts;
-    dit = data;
-    for_each_axis(axes, [&](const auto& a) {
-      using opt = axis::traits::static_options<decltype(a)>;
-      if (opt::test(axis::option::underflow)) {
-        if (dit->idx == 0) {
-          // axis has underflow and we are in the underflow bin:
-          // keep storage pointer unchanged
-          ++dit;
-          ++sit;
-          return;
-        }
-      }
-      if (opt::test(axis::option::overflow)) {
-        if (dit->idx == dit->old_extent - 1) {
-          // axis has overflow and we are in the overflow bin:
-          // move storage pointer to corresponding overflow bin position
-          ns += (axis::traits::extent(a) - 1) * dit->new_stride;
-          ++dit;
-          ++sit;
-          return;
-        }
-      }
-      // we are in a normal bin:
-      // move storage pointer to index position, apply positive shifts
-      ns += (dit->idx + std::max(*sit, 0)) * dit->new_stride;
-      ++dit;
-      ++sit;
-    });
-    // assign old value to new location
-    *ns = x;
-    // advance multi-dimensional index
-    dit = data;
-    ++dit->idx;
-    while (dit != dlast && dit->idx == dit->old_extent) {
-      dit->idx = 0;
-      ++(++dit)->idx;
+  const auto ob = storage.begin();
+  const auto nb = new_storage.begin();
+  grow_storage_blocks(axes, extents, shifts,
+                      [&ob, &nb](std::size_t i, std::size_t j, std::size_t n) {
+                        std::move(ob + i, ob + (i + n), nb + j);
+                      });
+  storage = std::move(new_storage);
+}
+
+// unlimited_storage: copy typed buffer directly, which keeps the current cell type
+template <class Allocator, class A>
+void grow_storage_copy(const A& axes, unlimited_storage<Allocator>& storage,
+                       const axis::index_type* extents, const axis::index_type* shifts) {
+  auto& buffer = unsafe_access::unlimited_storage_buffer(storage);
+  buffer.visit([&](const auto* p) {
+    using T = std::decay_t<decltype(*p)>;
+    std::decay_t<decltype(buffer)> new_buffer(buffer.alloc);
+    new_buffer.template make<T>(bincount(axes));
+    auto np = static_cast<T*>(new_buffer.ptr);
+    grow_storage_blocks(axes, extents, shifts,
+                        [p, np](std::size_t i, std::size_t j, std::size_t n) {
+                          std::copy(p + i, p + (i + n), np + j);
+                        });
+    buffer = std::move(new_buffer);
+  });
+}
+
+/* If only the last axis has grown, the cells of each bin of the last axis form a
+ * contiguous block, which keeps its position unless it is the overflow bin or bins were
+ * added at the lower end. The storage is then resized in place and only the affected
+ * blocks are moved. Bins added at the lower end move all normal blocks, there is no spare
+ * capacity in front of the first cell. Returns false if other axes have grown, too.
+ */
+template <class S, class A>
+bool grow_storage_last_axis(const A& axes, S& storage, const axis::index_type* extents,
+                            const axis::index_type* shifts) {
+  const auto rank = axes_rank(axes);
+  std::size_t block = 1;
+  axis::index_type new_extent = 0;
+  unsigned opt = 0;
+  bool last_only = true;
+  unsigned k = 0;
+  for_each_axis(axes, [&](const auto& a) {
+    const auto e = axis::traits::extent(a);
+    if (++k < rank) {
+      last_only &= (e == extents[k - 1]);
+      block *= static_cast<std::size_t>(e);
+    } else {
+      new_extent = e;
+      opt = axis::traits::options(a);
     }
+  });
+  if (!last_only) return false;
+
+  const auto old_extent = extents[rank - 1];
+  const auto shift = static_cast<std::size_t>(shifts[rank - 1]);
+  const std::size_t uf = opt & axis::option::underflow ? 1 : 0;
+  const std::size_t of = opt & axis::option::overflow ? 1 : 0;
+  const auto new_size = block * static_cast<std::size_t>(new_extent);
+  if (new_size > storage.capacity()) {
+    constexpr std::size_t limit = BOOST_HISTOGRAM_DETAIL_GROWTH_RESERVE_LIMIT;
+    storage.reserve(new_size + (std::min)(new_size, limit));
   }
-  storage = std::move(new_storage);
+  storage.resize(new_size);
+
+  using value_type = typename S::value_type;
+  const auto first = storage.begin();
+  const auto old_end = static_cast<std::size_t>(old_extent) - of;
+  // move overflow block to the new end, ranges do not overlap since the axis has grown
+  if (of)
+    std::move(first + old_end * block, first + (old_end + 1) * block,
+              first + (new_size - block));
+  // move normal blocks up if bins were added at the lower end
+  if (shift)
+    std::move_backward(first + uf * block, first + old_end * block,
+                       first + (old_end + shift) * block);
+  // reset new blocks
+  std::fill(first + uf * block, first + (uf + shift) * block, value_type());
+  std::fill(first + (old_end + shift) * block, first + (new_size - of * block),
+            value_type());
+  return true;
+}
+
+template <class S, class A>
+void grow_storage_impl(std::true_type, const A& axes, S& storage,
+                       const axis::index_type* extents, const axis::index_type* shifts) {
+  if (!grow_storage_last_axis(axes, storage, extents, shifts))
+    grow_storage_copy(axes, storage, extents, shifts);
+}
+
+template <class S, class A>
+void grow_storage_impl(std::false_type, const A& axes, S& storage,
+                       const axis::index_type* extents, const axis::index_type* shifts) {
+  grow_storage_copy(axes, storage, extents, shifts);
+}
+
+// extents are the axis extents before growing, shifts are the number of bins which were
+// added at the lower end of each axis (bins added at the upper end need no shift)
+template <class S, class A>
+void grow_storage(const A& axes, S& storage, const axis::index_type* extents,
+                  const axis::index_type* shifts) {
+  grow_storage_impl(mp11::mp_and<has_method_resize<S>, has_method_capacity<S>,
+                                 has_method_reserve<S>>{},
+                    axes, storage, extents, shifts);
+}
+
+// shifts are the values returned by axis::traits::update, positive if the axis has grown
+// at the lower end and negative if it has grown at the upper end
+template <class S, class A>
+void grow_storage(const A& axes, S& storage, const axis::index_type* shifts) {
+  axis::index_type extents[buffer_size<A>::value];
+  axis::index_type lower_shifts[buffer_size<A>::value];
+  auto eit = extents;
+  auto lit = lower_shifts;
+  const auto* sit = shifts;
+  for_each_axis(axes, [&](const auto& a) {
+    *eit++ = axis::traits::extent(a) - std::abs(*sit);
+    *lit++ = std::max(*sit++, 0);
+  });
+  grow_storage(axes, storage, extents, lower_shifts);
 }
 
 // histogram has no growing and no multidim axis, axis rank known at compile-time
@@ -271,9 +493,37 @@ optional_index index(std::false_type, std::true_type, const A& axes, S&, const U
   return idx;
 }
 
+// histogram has growing axis, compute index without growing; the index is invalid if the
+// value is outside of the axis range or an axis would have to grow
+template <class T, class U>
+optional_index index_probe(const T& axes, const U& args) {
+  optional_index idx;
+  constexpr unsigned nbuf = buffer_size<T>::value;
+  const auto rank = axes_rank(axes);
+  constexpr auto nargs = static_cast<unsigned>(std::tuple_size<U>::value);
+  if (rank == 1 && nargs > 1)
+    linearize_value_probe(idx, axis_get<0>(axes), args);
+  else {
+    if (rank != nargs)
+      BOOST_THROW_EXCEPTION(
+          std::invalid_argument("number of arguments != histogram rank"));
+    mp11::mp_for_each<mp11::mp_iota_c<(nargs < nbuf ? nargs : nbuf)>>([&](auto i) {
+      linearize_value_probe(idx, axis_get<i>(axes), std::get<i>(args));
+    });
+  }
+  return idx;
+}
+
 // histogram has growing axis
 template <class B, class T, class S, class U>
 optional_index index(std::true_type, B, T& axes, S& storage, const U& args) {
+  // values inside of the axes are found without copying the axes in growth_guard
+  if (growth_guard<T>::enabled) {
+    const auto idx = index_probe(axes, args);
+    if (idx) return idx;
+  }
+  growth_guard<T> guard{axes};
+
   optional_index idx;
   constexpr unsigned nbuf = buffer_size<T>::value;
   axis::index_type shifts[nbuf];
@@ -294,7 +544,10 @@ optional_index index(std::true_type, B, T& axes, S& storage, const U& args) {
     });
   }
 
-  if (update_needed) grow_storage(axes, storage, shifts);
+  if (update_needed) {
+    guard.check();
+    grow_storage(axes, storage, shifts);
+  }
   return idx;
 }
 
@@ -365,23 +618,76 @@ void fill_impl(IW, IS, std::false_type, T&& t, const U& u) noexcept {
                     std::get<IS::value>(u).value);
 }
 
+// storages which keep a separate part for each thread are filled through that part
+template <class S>
+decltype(auto) local_storage(std::true_type, S& storage) {
+  return storage.shard();
+}
+
+template <class S>
+S& local_storage(std::false_type, S& storage) {
+  return storage;
+}
+
+template <class S>
+decltype(auto) local_storage(S& storage) {
+  return local_storage(has_method_shard<S>{}, storage);
+}
+
+// position of the values in the argument tuple of fill, which may also contain a weight
+// and a sample
+template <class... Us>
+struct fill_args {
+  static constexpr int iw = weight_sample_indices<Us...>().first;
+  static constexpr int is = weight_sample_indices<Us...>().second;
+  static constexpr unsigned n = sizeof...(Us) - (iw > -1) - (is > -1);
+  static constexpr unsigned i = (iw == 0 || is == 0) ? (iw == 1 || is == 1 ? 2 : 1) : 0;
+};
+
+template <class S, class... Us>
+typename S::iterator fill_cell(S& storage, const std::size_t idx,
+                               const std::tuple<Us...>& tus) {
+  using F = fill_args<Us...>;
+  auto&& s = local_storage(storage);
+  fill_impl(mp11::mp_int<F::iw>{}, mp11::mp_int<F::is>{},
+            has_operator_preincrement<typename S::value_type>{}, s[idx], tus);
+  return s.begin() + idx;
+}
+
 template <class A, class S, class... Us>
 typename S::iterator fill(A& axes, S& storage, const std::tuple<Us...>& tus) {
-  constexpr auto iws = weight_sample_indices<Us...>();
-  constexpr unsigned n = sizeof...(Us) - (iws.first > -1) - (iws.second > -1);
-  constexpr unsigned i = (iws.first == 0 || iws.second == 0)
-                             ? (iws.first == 1 || iws.second == 1 ? 2 : 1)
-                             : 0;
+  using F = fill_args<Us...>;
   const auto idx = index(has_growing_axis<A>{}, has_multidim_axis<A>{}, axes, storage,
-                         tuple_slice<i, n>(tus));
-  if (idx) {
-    fill_impl(mp11::mp_int<iws.first>{}, mp11::mp_int<iws.second>{},
-              has_operator_preincrement<typename S::value_type>{}, storage[*idx], tus);
-    return storage.begin() + *idx;
-  }
+                         tuple_slice<F::i, F::n>(tus));
+  if (idx) return fill_cell(storage, *idx, tus);
   return storage.end();
 }
 
+template <class M, class A, class S, class... Us>
+typename S::iterator fill(M& mutex, A& axes, S& storage, const std::tuple<Us...>& tus) {
+  std::lock_guard<M> guard{mutex};
+  return fill(axes, storage, tus);
+}
+
+/* Thread-safe storage and growing axes: the index is first computed under a shared lock
+ * without changing the axes. If no axis has to grow, the cell is incremented under the
+ * shared lock, which is safe since the storage is thread-safe. Otherwise, the fill is
+ * repeated under the exclusive lock, which then lets the axes and the storage grow.
+ * Growing is rare, so that threads which fill concurrently usually do not wait.
+ */
+template <class A, class S, class... Us>
+typename S::iterator fill(std::shared_timed_mutex& mutex, A& axes, S& storage,
+                          const std::tuple<Us...>& tus) {
+  using F = fill_args<Us...>;
+  {
+    std::shared_lock<std::shared_timed_mutex> guard{mutex};
+    const auto idx = index_probe(axes, tuple_slice<F::i, F::n>(tus));
+    if (idx) return fill_cell(storage, *idx, tus);
+  }
+  std::lock_guard<std::shared_timed_mutex> guard{mutex};
+  return fill(axes, storage, tus);
+}
+
 template <class A, class... Us>
 optional_index at(const A& axes, const std::tuple<Us...>& args) {
   if (axes_rank(axes) != sizeof...(Us))
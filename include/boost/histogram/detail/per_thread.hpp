@@ -0,0 +1,109 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_DETAIL_PER_THREAD_HPP
+#define BOOST_HISTOGRAM_DETAIL_PER_THREAD_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace boost {
+namespace histogram {
+namespace detail {
+
+// returns a number which is unique for each call in the program
+inline std::size_t make_serial() noexcept {
+  static std::atomic<std::size_t> counter{0};
+  return ++counter;
+}
+
+/* Holds one instance of T for each thread which called local(). Each instance is
+ * allocated separately and padded, so that instances of different threads do not share
+ * cache lines. A thread finds its instance through a thread-local cache, so that the
+ * mutex is only locked on the first access of a thread. Copies are empty. Moving
+ * transfers the instances and invalidates the thread-local caches of the source.
+ */
+template <class T>
+class per_thread {
+public:
+  per_thread() = default;
+  per_thread(const per_thread&) {}
+  per_thread& operator=(const per_thread&) {
+    clear();
+    return *this;
+  }
+
+  per_thread(per_thread&& o)
+      : items_(std::move(o.items_)), serial_(std::exchange(o.serial_, make_serial())) {}
+
+  per_thread& operator=(per_thread&& o) {
+    if (this != &o) {
+      items_ = std::move(o.items_);
+      serial_ = std::exchange(o.serial_, make_serial());
+    }
+    return *this;
+  }
+
+  // returns the instance of the calling thread, make() creates it on first access
+  template <class F>
+  T& local(F&& make) {
+    struct cache_type {
+      const per_thread* owner = nullptr;
+      std::size_t serial = 0;
+      T* value = nullptr;
+    };
+    static thread_local cache_type cache;
+    if (cache.owner != this || cache.serial != serial_) {
+      std::lock_guard<std::mutex> guard{mutex_};
+      const auto id = std::this_thread::get_id();
+      auto it = std::find_if(items_.begin(), items_.end(),
+                             [id](const auto& x) { return x->id == id; });
+      if (it == items_.end()) {
+        items_.emplace_back(new item{make(), id});
+        it = items_.end() - 1;
+      }
+      cache = {this, serial_, &(*it)->value};
+    }
+    return *cache.value;
+  }
+
+  // calls f for the instance of each thread, must not run concurrently with local()
+  template <class F>
+  void for_each(F&& f) const {
+    std::lock_guard<std::mutex> guard{mutex_};
+    for (auto&& x : items_) f(x->value);
+  }
+
+  void clear() {
+    items_.clear();
+    serial_ = make_serial();
+  }
+
+private:
+  struct item {
+    T value;
+    std::thread::id id;
+    char padding[64];
+
+    item(T&& v, std::thread::id i) : value(std::move(v)), id(i) {}
+  };
+
+  std::vector<std::unique_ptr<item>> items_;
+  std::size_t serial_ = make_serial();
+  mutable std::mutex mutex_;
+};
+
+} // namespace detail
+} // namespace histogram
+} // namespace boost
+
+#endif
@@ -0,0 +1,227 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_DETAIL_PERFECT_HASH_INDEX_HPP
+#define BOOST_HISTOGRAM_DETAIL_PERFECT_HASH_INDEX_HPP
+
+#include <algorithm>
+#include <boost/histogram/detail/hash_index.hpp>
+#include <boost/histogram/detail/static_if.hpp>
+#include <boost/histogram/fwd.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace boost {
+namespace histogram {
+namespace detail {
+
+/*
+  Index of a fixed sequence of unique values, which finds the position of a value with
+  one hash computation and one comparison.
+
+  Integers which span a small range are looked up directly in a table which has one
+  entry per integer in the range.
+
+  Other values use a minimal perfect hash, built with the hash-and-displace method: the
+  values are distributed into buckets by their hash, and for each bucket a displacement
+  is searched which moves all values of the bucket into free slots of a table with
+  exactly one slot per value. Buckets with a single value are placed in any free slot
+  directly and store the slot instead of a displacement. Large buckets are placed first,
+  while most slots are free.
+
+  Appending a value rebuilds the index, so it is only efficient for sequences which are
+  not changed after construction.
+*/
+template <class Allocator>
+class perfect_hash_index {
+  using value_type = typename std::allocator_traits<Allocator>::value_type;
+  using hash_type = key_hash<value_type>;
+  using slot_allocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<axis::index_type>;
+  using bucket_allocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<std::uint32_t>;
+
+  // displacements with this bit set are the slot of a single value
+  static constexpr std::uint32_t direct = 1u << 31;
+  // average number of values per bucket
+  static constexpr std::size_t bucket_load = 2;
+  // a bucket for which no displacement is found below this limit fails the build
+  static constexpr std::uint32_t max_displacement = 1u << 20;
+
+public:
+  explicit perfect_hash_index(const Allocator& a = {})
+      : slots_(slot_allocator(a)), buckets_(bucket_allocator(a)) {}
+
+  bool empty() const noexcept { return slots_.empty(); }
+
+  // returns v.size() if x is not found
+  template <class Vector, class U>
+  axis::index_type find(const Vector& v, const U& x) const noexcept {
+    return static_if<std::is_integral<U>>(
+        [this, &v](const auto& y) {
+          if (buckets_.empty()) {
+            const auto k = static_cast<std::uint64_t>(y) - offset_;
+            if (k < slots_.size()) return slots_[k];
+            return static_cast<axis::index_type>(v.size());
+          }
+          return this->find_hashed(v, y);
+        },
+        [this, &v](const auto& y) { return this->find_hashed(v, y); }, x);
+  }
+
+  // index is built if v has at least min_size values or consists of integers which
+  // span a small range
+  template <class Vector>
+  void rebuild(const Vector& v, std::size_t min_size) {
+    slots_.clear();
+    buckets_.clear();
+    if (v.empty()) return;
+    if (static_if<std::is_integral<value_type>>(
+            [this](const auto& w) { return this->build_table(w); },
+            [](const auto&) { return false; }, v))
+      return;
+    if (v.size() >= min_size && !build_hash(v)) {
+      slots_.clear();
+      buckets_.clear();
+    }
+  }
+
+  // must be called after a new value was appended to v
+  template <class Vector>
+  void push_back(const Vector& v, std::size_t min_size) {
+    rebuild(v, min_size);
+  }
+
+private:
+  template <class Vector, class U>
+  axis::index_type find_hashed(const Vector& v, const U& x) const noexcept {
+    const std::uint64_t h = hash_type{}(x);
+    const std::uint32_t d = buckets_[reduce(h, buckets_.size())];
+    const auto i = slots_[(d & direct) ? d ^ direct : slot(h, d)];
+    return v[i] == x ? i : static_cast<axis::index_type>(v.size());
+  }
+
+  // maps the lower 32 bits of h to [0, n) without a division
+  static std::size_t reduce(std::uint64_t h, std::size_t n) noexcept {
+    return static_cast<std::size_t>(((h & 0xffffffff) * n) >> 32);
+  }
+
+  std::size_t slot(std::uint64_t h, std::uint32_t d) const noexcept {
+    return reduce(mix_hash(h ^ (0x9e3779b97f4a7c15ULL * (d + 1))), slots_.size());
+  }
+
+  template <class Vector>
+  bool build_table(const Vector& v) {
+    const auto mm = std::minmax_element(v.begin(), v.end());
+    const auto range = static_cast<std::uint64_t>(*mm.second) -
+                       static_cast<std::uint64_t>(*mm.first) + 1;
+    // range is zero if the values span all integers of a 64 bit type
+    if (range == 0 || range > std::max<std::uint64_t>(64, 4 * v.size())) return false;
+    offset_ = static_cast<std::uint64_t>(*mm.first);
+    const auto n = static_cast<axis::index_type>(v.size());
+    slots_.assign(static_cast<std::size_t>(range), n);
+    // iterate backwards, so that the first of several equal values wins
+    for (auto i = n; i-- > 0;)
+      slots_[static_cast<std::uint64_t>(v[i]) - offset_] = i;
+    return true;
+  }
+
+  template <class Vector>
+  bool build_hash(const Vector& v) {
+    const std::size_t n = v.size();
+    if (n >= direct) return false;
+    const std::size_t nb = (n + bucket_load - 1) / bucket_load;
+
+    std::vector<std::uint64_t> hashes(n);
+    std::vector<std::size_t> order(n);
+    for (std::size_t i = 0; i < n; ++i) {
+      hashes[i] = hash_type{}(v[i]);
+      order[i] = i;
+    }
+    // sort values by bucket and within each bucket by position
+    std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+      const auto ba = reduce(hashes[a], nb);
+      const auto bb = reduce(hashes[b], nb);
+      return ba < bb || (ba == bb && a < b);
+    });
+    // ranges of values in order for each non-empty bucket, largest first
+    struct range_type {
+      std::size_t bucket, begin, end;
+    };
+    std::vector<range_type> ranges;
+    for (std::size_t i = 0; i < n;) {
+      const auto b = reduce(hashes[order[i]], nb);
+      std::size_t j = i + 1;
+      while (j < n && reduce(hashes[order[j]], nb) == b) ++j;
+      ranges.push_back({b, i, j});
+      i = j;
+    }
+    std::stable_sort(ranges.begin(), ranges.end(), [](const auto& a, const auto& b) {
+      return a.end - a.begin > b.end - b.begin;
+    });
+
+    slots_.assign(n, 0);
+    buckets_.assign(nb, 0);
+    std::vector<bool> used(n, false);
+    std::vector<std::size_t> pos;
+    std::size_t free = 0; // all slots below are used
+    for (const auto& r : ranges) {
+      // equal values have equal hashes, only the first one is stored
+      pos.clear();
+      for (auto k = r.begin; k < r.end; ++k) {
+        bool duplicate = false;
+        for (auto l = r.begin; l < k; ++l) {
+          if (hashes[order[l]] != hashes[order[k]]) continue;
+          // two different values with the same hash cannot be separated
+          if (!(v[order[l]] == v[order[k]])) return false;
+          duplicate = true;
+        }
+        if (!duplicate) pos.push_back(order[k]);
+      }
+
+      if (pos.size() == 1) {
+        while (used[free]) ++free;
+        used[free] = true;
+        slots_[free] = static_cast<axis::index_type>(pos[0]);
+        buckets_[r.bucket] = static_cast<std::uint32_t>(free) | direct;
+        continue;
+      }
+
+      std::vector<std::size_t> s(pos.size());
+      std::uint32_t d = 0;
+      for (;; ++d) {
+        if (d == max_displacement) return false;
+        bool ok = true;
+        for (std::size_t k = 0; ok && k < pos.size(); ++k) {
+          s[k] = slot(hashes[pos[k]], d);
+          ok = !used[s[k]] && std::find(s.begin(), s.begin() + k, s[k]) == s.begin() + k;
+        }
+        if (ok) break;
+      }
+      for (std::size_t k = 0; k < pos.size(); ++k) {
+        used[s[k]] = true;
+        slots_[s[k]] = static_cast<axis::index_type>(pos[k]);
+      }
+      buckets_[r.bucket] = d;
+    }
+    return true;
+  }
+
+  // slots hold positions in the value sequence; if there are no buckets, slots is the
+  // table of positions for integers starting at offset
+  std::vector<axis::index_type, slot_allocator> slots_;
+  std::vector<std::uint32_t, bucket_allocator> buckets_;
+  std::uint64_t offset_ = 0;
+};
+
+} // namespace detail
+} // namespace histogram
+} // namespace boost
+
+#endif
@@ -0,0 +1,152 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_DETAIL_PROBE_ORDER_HPP
+#define BOOST_HISTOGRAM_DETAIL_PROBE_ORDER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <boost/histogram/fwd.hpp>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+namespace boost {
+namespace histogram {
+namespace detail {
+
+/*
+  Order in which a linear search visits a sequence of values, which adapts to the
+  frequency of the values that are found. The sequence itself is not changed, so
+  positions returned by find() are stable.
+
+  When a value is found at rank k > 0 of the order, it is swapped with the value at rank
+  k / 2, so that a frequent value reaches the front in a logarithmic number of steps.
+  Only every sample_period-th hit of a thread is used, so that most lookups do not write.
+
+  find() may be called concurrently from several threads. The order is an array of
+  atomic positions, which is changed by one thread at a time; the others skip the
+  adaptation while it is locked. A value which is moved while a thread searches for it
+  may be skipped by that thread, so a value which is not found is only reported as
+  missing if the order did not change during the search (seqlock). Otherwise, the search
+  is repeated in the order of the sequence.
+*/
+template <class Allocator>
+class probe_order {
+  using rank_type = std::atomic<axis::index_type>;
+  using rank_allocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<rank_type>;
+  using ranks_type = std::vector<rank_type, rank_allocator>;
+
+  static constexpr unsigned sample_period = 8;
+
+public:
+  explicit probe_order(const Allocator& a = {}) : ranks_(rank_allocator(a)) {}
+
+  probe_order(const probe_order& o) : ranks_(o.ranks_.size(), o.ranks_.get_allocator()) {
+    copy(o);
+  }
+
+  // atomics cannot be moved, so vectors of ranks are only swapped, never assigned
+  probe_order& operator=(const probe_order& o) {
+    if (this != &o) {
+      ranks_type r(o.ranks_.size(), ranks_.get_allocator());
+      ranks_.swap(r);
+      copy(o);
+    }
+    return *this;
+  }
+
+  probe_order(probe_order&& o) noexcept : ranks_(std::move(o.ranks_)) {}
+
+  // without a common allocator, the order is dropped and the search uses the order of
+  // the sequence
+  probe_order& operator=(probe_order&& o) noexcept {
+    if (ranks_.get_allocator() == o.ranks_.get_allocator())
+      ranks_.swap(o.ranks_);
+    else
+      ranks_.clear();
+    return *this;
+  }
+
+  bool empty() const noexcept { return ranks_.empty(); }
+
+  // returns v.size() if x is not found
+  template <class Vector, class U>
+  axis::index_type find(const Vector& v, const U& x) const noexcept {
+    const auto n = ranks_.size();
+    const auto v1 = version_.load(std::memory_order_acquire);
+    for (std::size_t k = 0; k < n; ++k) {
+      // if this sees a change of the order, the version load below sees the new version
+      const auto i = ranks_[k].load(std::memory_order_acquire);
+      if (v[i] == x) {
+        if (k > 0) promote(k, i);
+        return i;
+      }
+    }
+    if ((v1 & 1) == 0 && version_.load(std::memory_order_relaxed) == v1)
+      return static_cast<axis::index_type>(n);
+    return static_cast<axis::index_type>(
+        std::distance(v.begin(), std::find(v.begin(), v.end(), x)));
+  }
+
+  // starts with the order of the sequence; no order is kept for fewer than two values
+  void reset(std::size_t n) {
+    if (n < 2) n = 0;
+    ranks_type r(n, ranks_.get_allocator());
+    for (std::size_t k = 0; k < n; ++k)
+      r[k].store(static_cast<axis::index_type>(k), std::memory_order_relaxed);
+    ranks_.swap(r);
+  }
+
+  // must be called after a new value was appended to the sequence, new values are
+  // visited last; must not run concurrently with find()
+  void push_back(std::size_t n) {
+    if (ranks_.empty()) {
+      reset(n);
+      return;
+    }
+    ranks_type r(n, ranks_.get_allocator());
+    for (std::size_t k = 0; k < ranks_.size(); ++k)
+      r[k].store(ranks_[k].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    r[n - 1].store(static_cast<axis::index_type>(n - 1), std::memory_order_relaxed);
+    ranks_.swap(r);
+  }
+
+private:
+  void copy(const probe_order& o) noexcept {
+    for (std::size_t k = 0; k < ranks_.size(); ++k)
+      ranks_[k].store(o.ranks_[k].load(std::memory_order_relaxed),
+                      std::memory_order_relaxed);
+  }
+
+  void promote(std::size_t k, axis::index_type i) const noexcept {
+    static thread_local unsigned tick = 0;
+    if (++tick % sample_period != 0) return;
+    auto v = version_.load(std::memory_order_relaxed);
+    // odd version means that another thread is changing the order
+    if ((v & 1) != 0 ||
+        !version_.compare_exchange_strong(v, v + 1, std::memory_order_acquire))
+      return;
+    // another thread may have moved i since it was found
+    if (ranks_[k].load(std::memory_order_relaxed) == i) {
+      auto& r = ranks_[k / 2];
+      ranks_[k].store(r.load(std::memory_order_relaxed), std::memory_order_release);
+      r.store(i, std::memory_order_release);
+    }
+    version_.store(v + 2, std::memory_order_release);
+  }
+
+  mutable ranks_type ranks_;
+  mutable std::atomic<unsigned> version_{0};
+};
+
+} // namespace detail
+} // namespace histogram
+} // namespace boost
+
+#endif
@@ -0,0 +1,425 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_DETAIL_SIMD_HPP
+#define BOOST_HISTOGRAM_DETAIL_SIMD_HPP
+
+#include <boost/histogram/fwd.hpp>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+/*
+  Vectorized kernels for batch filling. They are compiled for several instruction sets
+  with function attributes and the best one is selected once at run-time, so the library
+  stays header-only and needs no special compiler flags. Kernels which are called for
+  single values use only SSE2. Define BOOST_HISTOGRAM_NO_SIMD to always use the portable
+  scalar code.
+*/
+#if !defined(BOOST_HISTOGRAM_NO_SIMD) && (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define BOOST_HISTOGRAM_DETAIL_SIMD_X86 1
+#include <immintrin.h>
+#define BOOST_HISTOGRAM_DETAIL_TARGET(x) __attribute__((target(x)))
+#else
+#define BOOST_HISTOGRAM_DETAIL_SIMD_X86 0
+#endif
+
+namespace boost {
+namespace histogram {
+namespace detail {
+
+/*
+  Computes bin indices of a non-circular regular axis with identity transform. Must
+  produce exactly the same results as axis::regular::index, including for values at bin
+  edges, NaN, and infinities. Therefore, the vectorized kernels perform exactly the same
+  floating point operations in the same order as the scalar code. The result is computed
+  as a floating point number first, -1 for underflow and size for overflow, which is
+  then truncated to an integer.
+*/
+template <class T>
+void regular_index_n_scalar(const T* x, axis::index_type* out, std::size_t n,
+                            const T min, const T delta, const T size) noexcept {
+  for (const auto end = x + n; x != end; ++x, ++out) {
+    const T z = (*x - min) / delta;
+    if (z < 1)
+      *out = z >= 0 ? static_cast<axis::index_type>(z * size) : -1;
+    else
+      *out = static_cast<axis::index_type>(size); // also for NaN
+  }
+}
+
+template <class T>
+using regular_index_n_kernel = void (*)(const T*, axis::index_type*, std::size_t, T, T,
+                                        T);
+
+#if BOOST_HISTOGRAM_DETAIL_SIMD_X86
+
+BOOST_HISTOGRAM_DETAIL_TARGET("sse2")
+inline void regular_index_n_sse2(const double* x, axis::index_type* out, std::size_t n,
+                                 const double min, const double delta,
+                                 const double size) noexcept {
+  const auto vmin = _mm_set1_pd(min);
+  const auto vdelta = _mm_set1_pd(delta);
+  const auto vsize = _mm_set1_pd(size);
+  const auto zero = _mm_setzero_pd();
+  const auto one = _mm_set1_pd(1);
+  const auto minus_one = _mm_set1_pd(-1);
+  for (; n >= 2; n -= 2, x += 2, out += 2) {
+    const auto z = _mm_div_pd(_mm_sub_pd(_mm_loadu_pd(x), vmin), vdelta);
+    const auto ge0 = _mm_cmpge_pd(z, zero);
+    const auto lt1 = _mm_cmplt_pd(z, one);
+    auto r = _mm_or_pd(_mm_and_pd(ge0, _mm_mul_pd(z, vsize)),
+                       _mm_andnot_pd(ge0, minus_one));
+    r = _mm_or_pd(_mm_and_pd(lt1, r), _mm_andnot_pd(lt1, vsize));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(out), _mm_cvttpd_epi32(r));
+  }
+  regular_index_n_scalar(x, out, n, min, delta, size);
+}
+
+BOOST_HISTOGRAM_DETAIL_TARGET("sse2")
+inline void regular_index_n_sse2(const float* x, axis::index_type* out, std::size_t n,
+                                 const float min, const float delta,
+                                 const float size) noexcept {
+  const auto vmin = _mm_set1_ps(min);
+  const auto vdelta = _mm_set1_ps(delta);
+  const auto vsize = _mm_set1_ps(size);
+  const auto zero = _mm_setzero_ps();
+  const auto one = _mm_set1_ps(1);
+  const auto minus_one = _mm_set1_ps(-1);
+  for (; n >= 4; n -= 4, x += 4, out += 4) {
+    const auto z = _mm_div_ps(_mm_sub_ps(_mm_loadu_ps(x), vmin), vdelta);
+    const auto ge0 = _mm_cmpge_ps(z, zero);
+    const auto lt1 = _mm_cmplt_ps(z, one);
+    auto r = _mm_or_ps(_mm_and_ps(ge0, _mm_mul_ps(z, vsize)),
+                       _mm_andnot_ps(ge0, minus_one));
+    r = _mm_or_ps(_mm_and_ps(lt1, r), _mm_andnot_ps(lt1, vsize));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_cvttps_epi32(r));
+  }
+  regular_index_n_scalar(x, out, n, min, delta, size);
+}
+
+BOOST_HISTOGRAM_DETAIL_TARGET("avx2")
+inline void regular_index_n_avx2(const double* x, axis::index_type* out, std::size_t n,
+                                 const double min, const double delta,
+                                 const double size) noexcept {
+  const auto vmin = _mm256_set1_pd(min);
+  const auto vdelta = _mm256_set1_pd(delta);
+  const auto vsize = _mm256_set1_pd(size);
+  const auto zero = _mm256_setzero_pd();
+  const auto one = _mm256_set1_pd(1);
+  const auto minus_one = _mm256_set1_pd(-1);
+  for (; n >= 4; n -= 4, x += 4, out += 4) {
+    const auto z = _mm256_div_pd(_mm256_sub_pd(_mm256_loadu_pd(x), vmin), vdelta);
+    const auto ge0 = _mm256_cmp_pd(z, zero, _CMP_GE_OQ);
+    const auto lt1 = _mm256_cmp_pd(z, one, _CMP_LT_OQ);
+    auto r = _mm256_blendv_pd(minus_one, _mm256_mul_pd(z, vsize), ge0);
+    r = _mm256_blendv_pd(vsize, r, lt1);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm256_cvttpd_epi32(r));
+  }
+  regular_index_n_scalar(x, out, n, min, delta, size);
+}
+
+BOOST_HISTOGRAM_DETAIL_TARGET("avx2")
+inline void regular_index_n_avx2(const float* x, axis::index_type* out, std::size_t n,
+                                 const float min, const float delta,
+                                 const float size) noexcept {
+  const auto vmin = _mm256_set1_ps(min);
+  const auto vdelta = _mm256_set1_ps(delta);
+  const auto vsize = _mm256_set1_ps(size);
+  const auto zero = _mm256_setzero_ps();
+  const auto one = _mm256_set1_ps(1);
+  const auto minus_one = _mm256_set1_ps(-1);
+  for (; n >= 8; n -= 8, x += 8, out += 8) {
+    const auto z = _mm256_div_ps(_mm256_sub_ps(_mm256_loadu_ps(x), vmin), vdelta);
+    const auto ge0 = _mm256_cmp_ps(z, zero, _CMP_GE_OQ);
+    const auto lt1 = _mm256_cmp_ps(z, one, _CMP_LT_OQ);
+    auto r = _mm256_blendv_ps(minus_one, _mm256_mul_ps(z, vsize), ge0);
+    r = _mm256_blendv_ps(vsize, r, lt1);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_cvttps_epi32(r));
+  }
+  regular_index_n_scalar(x, out, n, min, delta, size);
+}
+
+BOOST_HISTOGRAM_DETAIL_TARGET("avx512f")
+inline void regular_index_n_avx512(const double* x, axis::index_type* out, std::size_t n,
+                                   const double min, const double delta,
+                                   const double size) noexcept {
+  const auto vmin = _mm512_set1_pd(min);
+  const auto vdelta = _mm512_set1_pd(delta);
+  const auto vsize = _mm512_set1_pd(size);
+  const auto zero = _mm512_setzero_pd();
+  const auto one = _mm512_set1_pd(1);
+  const auto minus_one = _mm512_set1_pd(-1);
+  for (; n >= 8; n -= 8, x += 8, out += 8) {
+    const auto z = _mm512_div_pd(_mm512_sub_pd(_mm512_loadu_pd(x), vmin), vdelta);
+    const auto ge0 = _mm512_cmp_pd_mask(z, zero, _CMP_GE_OQ);
+    const auto lt1 = _mm512_cmp_pd_mask(z, one, _CMP_LT_OQ);
+    auto r = _mm512_mask_blend_pd(ge0, minus_one, _mm512_mul_pd(z, vsize));
+    r = _mm512_mask_blend_pd(lt1, vsize, r);
+    // maskz variant avoids a spurious -Wmaybe-uninitialized in some gcc versions
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out),
+                        _mm512_maskz_cvttpd_epi32(0xff, r));
+  }
+  regular_index_n_scalar(x, out, n, min, delta, size);
+}
+
+BOOST_HISTOGRAM_DETAIL_TARGET("avx512f")
+inline void regular_index_n_avx512(const float* x, axis::index_type* out, std::size_t n,
+                                   const float min, const float delta,
+                                   const float size) noexcept {
+  const auto vmin = _mm512_set1_ps(min);
+  const auto vdelta = _mm512_set1_ps(delta);
+  const auto vsize = _mm512_set1_ps(size);
+  const auto zero = _mm512_setzero_ps();
+  const auto one = _mm512_set1_ps(1);
+  const auto minus_one = _mm512_set1_ps(-1);
+  for (; n >= 16; n -= 16, x += 16, out += 16) {
+    const auto z = _mm512_div_ps(_mm512_sub_ps(_mm512_loadu_ps(x), vmin), vdelta);
+    const auto ge0 = _mm512_cmp_ps_mask(z, zero, _CMP_GE_OQ);
+    const auto lt1 = _mm512_cmp_ps_mask(z, one, _CMP_LT_OQ);
+    auto r = _mm512_mask_blend_ps(ge0, minus_one, _mm512_mul_ps(z, vsize));
+    r = _mm512_mask_blend_ps(lt1, vsize, r);
+    // maskz variant avoids a spurious -Wmaybe-uninitialized in some gcc versions
+    _mm512_storeu_si512(out, _mm512_maskz_cvttps_epi32(0xffff, r));
+  }
+  regular_index_n_scalar(x, out, n, min, delta, size);
+}
+
+template <class T>
+regular_index_n_kernel<T> select_regular_index_n() noexcept {
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) return regular_index_n_avx512;
+  if (__builtin_cpu_supports("avx2")) return regular_index_n_avx2;
+  if (__builtin_cpu_supports("sse2")) return regular_index_n_sse2;
+  return regular_index_n_scalar<T>;
+}
+
+#else
+
+template <class T>
+regular_index_n_kernel<T> select_regular_index_n() noexcept {
+  return regular_index_n_scalar<T>;
+}
+
+#endif
+
+/*
+  Natural logarithm of a positive normal number with an absolute error below 1e-10,
+  without a call to std::log. The argument is split into 2^e m with m in [sqrt(1/2),
+  sqrt(2)) by integer operations on its representation, then log(m) = 2 atanh(s) with
+  s = (m - 1) / (m + 1), |s| < 0.172, is computed from its Taylor series up to s^11. The
+  truncation error is below 2e-11, rounding adds a few ulp of the result. The code has
+  no branches and only uses operations which are also available for SIMD registers, so
+  that the vectorized kernels below compute exactly the same result.
+*/
+inline double fast_log_normal(double x) noexcept {
+  std::uint64_t u;
+  std::memcpy(&u, &x, sizeof(u));
+  // shift the high word by 0x3ff00000 - 0x3fe6a09e, the high word of sqrt(1/2)
+  const std::uint64_t h = (u >> 32) + 0x95f62;
+  const double e = static_cast<double>(static_cast<int>(h >> 20) - 1023);
+  u = (((h & 0xfffff) + 0x3fe6a09e) << 32) | (u & 0xffffffff);
+  double m;
+  std::memcpy(&m, &u, sizeof(m));
+  const double f = m - 1;
+  const double s = f / (2 + f);
+  const double z = s * s;
+  const double r =
+      z * (1.0 / 3 + z * (1.0 / 5 + z * (1.0 / 7 + z * (1.0 / 9 + z * (1.0 / 11)))));
+  const double t = s + s;
+  return e * 0.69314718055994530942 + (t + t * r);
+}
+
+// uses std::log for arguments which are not positive normal numbers
+template <class T>
+T fast_log(const T x) noexcept {
+  if (x >= std::numeric_limits<T>::min() && x <= std::numeric_limits<T>::max())
+    return static_cast<T>(fast_log_normal(static_cast<double>(x)));
+  return std::log(x);
+}
+
+inline void fast_log_n_scalar(const double* x, double* y, std::size_t n) noexcept {
+  for (const auto end = x + n; x != end; ++x, ++y) *y = fast_log(*x);
+}
+
+using fast_log_n_kernel = void (*)(const double*, double*, std::size_t);
+
+#if BOOST_HISTOGRAM_DETAIL_SIMD_X86
+
+BOOST_HISTOGRAM_DETAIL_TARGET("sse2")
+inline void fast_log_n_sse2(const double* x, double* y, std::size_t n) noexcept {
+  const auto low_word = _mm_set1_epi64x(0xffffffff);
+  const auto offset = _mm_set1_epi64x(0x95f62);
+  const auto mantissa = _mm_set1_epi64x(0xfffff);
+  const auto sqrt_half = _mm_set1_epi64x(0x3fe6a09e);
+  // or-ing a small integer into the mantissa of 2^52 converts it exactly to double
+  const auto two52 = _mm_set1_epi64x(0x4330000000000000);
+  const auto bias = _mm_set1_pd(4503599627370496.0 + 1023);
+  const auto lowest = _mm_set1_pd(std::numeric_limits<double>::min());
+  const auto highest = _mm_set1_pd(std::numeric_limits<double>::max());
+  const auto one = _mm_set1_pd(1);
+  const auto two = _mm_set1_pd(2);
+  const auto ln2 = _mm_set1_pd(0.69314718055994530942);
+  const auto c3 = _mm_set1_pd(1.0 / 3);
+  const auto c5 = _mm_set1_pd(1.0 / 5);
+  const auto c7 = _mm_set1_pd(1.0 / 7);
+  const auto c9 = _mm_set1_pd(1.0 / 9);
+  const auto c11 = _mm_set1_pd(1.0 / 11);
+  for (; n >= 2; n -= 2, x += 2, y += 2) {
+    const auto vx = _mm_loadu_pd(x);
+    const auto u = _mm_castpd_si128(vx);
+    const auto h = _mm_add_epi64(_mm_srli_epi64(u, 32), offset);
+    const auto e =
+        _mm_sub_pd(_mm_castsi128_pd(_mm_or_si128(_mm_srli_epi64(h, 20), two52)), bias);
+    const auto m = _mm_castsi128_pd(_mm_or_si128(
+        _mm_slli_epi64(_mm_add_epi64(_mm_and_si128(h, mantissa), sqrt_half), 32),
+        _mm_and_si128(u, low_word)));
+    const auto f = _mm_sub_pd(m, one);
+    const auto s = _mm_div_pd(f, _mm_add_pd(two, f));
+    const auto z = _mm_mul_pd(s, s);
+    auto r = _mm_add_pd(c9, _mm_mul_pd(z, c11));
+    r = _mm_add_pd(c7, _mm_mul_pd(z, r));
+    r = _mm_add_pd(c5, _mm_mul_pd(z, r));
+    r = _mm_add_pd(c3, _mm_mul_pd(z, r));
+    r = _mm_mul_pd(z, r);
+    const auto t = _mm_add_pd(s, s);
+    _mm_storeu_pd(y, _mm_add_pd(_mm_mul_pd(e, ln2), _mm_add_pd(t, _mm_mul_pd(t, r))));
+    const auto normal = _mm_and_pd(_mm_cmpge_pd(vx, lowest), _mm_cmple_pd(vx, highest));
+    if (_mm_movemask_pd(normal) != 0x3) fast_log_n_scalar(x, y, 2);
+  }
+  fast_log_n_scalar(x, y, n);
+}
+
+BOOST_HISTOGRAM_DETAIL_TARGET("avx2")
+inline void fast_log_n_avx2(const double* x, double* y, std::size_t n) noexcept {
+  const auto low_word = _mm256_set1_epi64x(0xffffffff);
+  const auto offset = _mm256_set1_epi64x(0x95f62);
+  const auto mantissa = _mm256_set1_epi64x(0xfffff);
+  const auto sqrt_half = _mm256_set1_epi64x(0x3fe6a09e);
+  const auto two52 = _mm256_set1_epi64x(0x4330000000000000);
+  const auto bias = _mm256_set1_pd(4503599627370496.0 + 1023);
+  const auto lowest = _mm256_set1_pd(std::numeric_limits<double>::min());
+  const auto highest = _mm256_set1_pd(std::numeric_limits<double>::max());
+  const auto one = _mm256_set1_pd(1);
+  const auto two = _mm256_set1_pd(2);
+  const auto ln2 = _mm256_set1_pd(0.69314718055994530942);
+  const auto c3 = _mm256_set1_pd(1.0 / 3);
+  const auto c5 = _mm256_set1_pd(1.0 / 5);
+  const auto c7 = _mm256_set1_pd(1.0 / 7);
+  const auto c9 = _mm256_set1_pd(1.0 / 9);
+  const auto c11 = _mm256_set1_pd(1.0 / 11);
+  for (; n >= 4; n -= 4, x += 4, y += 4) {
+    const auto vx = _mm256_loadu_pd(x);
+    const auto u = _mm256_castpd_si256(vx);
+    const auto h = _mm256_add_epi64(_mm256_srli_epi64(u, 32), offset);
+    const auto e = _mm256_sub_pd(
+        _mm256_castsi256_pd(_mm256_or_si256(_mm256_srli_epi64(h, 20), two52)), bias);
+    const auto m = _mm256_castsi256_pd(_mm256_or_si256(
+        _mm256_slli_epi64(_mm256_add_epi64(_mm256_and_si256(h, mantissa), sqrt_half), 32),
+        _mm256_and_si256(u, low_word)));
+    const auto f = _mm256_sub_pd(m, one);
+    const auto s = _mm256_div_pd(f, _mm256_add_pd(two, f));
+    const auto z = _mm256_mul_pd(s, s);
+    auto r = _mm256_add_pd(c9, _mm256_mul_pd(z, c11));
+    r = _mm256_add_pd(c7, _mm256_mul_pd(z, r));
+    r = _mm256_add_pd(c5, _mm256_mul_pd(z, r));
+    r = _mm256_add_pd(c3, _mm256_mul_pd(z, r));
+    r = _mm256_mul_pd(z, r);
+    const auto t = _mm256_add_pd(s, s);
+    _mm256_storeu_pd(
+        y, _mm256_add_pd(_mm256_mul_pd(e, ln2), _mm256_add_pd(t, _mm256_mul_pd(t, r))));
+    const auto normal = _mm256_and_pd(_mm256_cmp_pd(vx, lowest, _CMP_GE_OQ),
+                                      _mm256_cmp_pd(vx, highest, _CMP_LE_OQ));
+    if (_mm256_movemask_pd(normal) != 0xf) fast_log_n_scalar(x, y, 4);
+  }
+  fast_log_n_sse2(x, y, n);
+}
+
+inline fast_log_n_kernel select_fast_log_n() noexcept {
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) return fast_log_n_avx2;
+  if (__builtin_cpu_supports("sse2")) return fast_log_n_sse2;
+  return fast_log_n_scalar;
+}
+
+#else
+
+inline fast_log_n_kernel select_fast_log_n() noexcept { return fast_log_n_scalar; }
+
+#endif
+
+// computes fast_log for n values
+inline void fast_log_n(const double* x, double* y, std::size_t n) noexcept {
+  static const auto kernel = select_fast_log_n();
+  kernel(x, y, n);
+}
+
+inline void fast_log_n(const float* x, float* y, std::size_t n) noexcept {
+  for (const auto end = x + n; x != end; ++x, ++y) *y = fast_log(*x);
+}
+
+/*
+  Returns the number of values in v[0, n) which are not greater than x, which is the
+  position found by std::upper_bound in a sorted sequence. NaN is not less than any
+  value, so the result for NaN is n, like for std::upper_bound. All values are compared
+  without branches, which beats a binary search for short sequences. SSE2 is part of
+  x86-64, so the vectorized versions are used whenever the compiler enables SSE2,
+  without a selection at run-time, which would cost more than the scan itself.
+*/
+template <class T>
+std::size_t upper_bound_scan(const T* v, std::size_t n, const T x) noexcept {
+  std::size_t c = 0;
+  for (std::size_t k = 0; k < n; ++k) c += !(x < v[k]);
+  return c;
+}
+
+#if BOOST_HISTOGRAM_DETAIL_SIMD_X86 && defined(__SSE2__)
+
+inline std::size_t upper_bound_scan(const double* v, std::size_t n,
+                                    const double x) noexcept {
+  const auto vx = _mm_set1_pd(x);
+  // comparison yields -1 in lanes where x is not less than the value
+  auto c = _mm_setzero_si128();
+  std::size_t k = 0;
+  for (; k + 2 <= n; k += 2)
+    c = _mm_sub_epi64(c, _mm_castpd_si128(_mm_cmpnlt_pd(vx, _mm_loadu_pd(v + k))));
+  c = _mm_add_epi64(c, _mm_unpackhi_epi64(c, c));
+  // count fits into the lower 32 bits, _mm_cvtsi128_si64 is not available on x86-32
+  return static_cast<std::size_t>(_mm_cvtsi128_si32(c)) +
+         upper_bound_scan<double>(v + k, n - k, x);
+}
+
+inline std::size_t upper_bound_scan(const float* v, std::size_t n,
+                                    const float x) noexcept {
+  const auto vx = _mm_set1_ps(x);
+  auto c = _mm_setzero_si128();
+  std::size_t k = 0;
+  for (; k + 4 <= n; k += 4)
+    c = _mm_sub_epi32(c, _mm_castps_si128(_mm_cmpnlt_ps(vx, _mm_loadu_ps(v + k))));
+  c = _mm_add_epi32(c, _mm_shuffle_epi32(c, _MM_SHUFFLE(1, 0, 3, 2)));
+  c = _mm_add_epi32(c, _mm_shuffle_epi32(c, _MM_SHUFFLE(2, 3, 0, 1)));
+  return static_cast<std::size_t>(_mm_cvtsi128_si32(c)) +
+         upper_bound_scan<float>(v + k, n - k, x);
+}
+
+#endif
+
+// T must be float or double
+template <class T>
+void regular_index_n(const T* x, axis::index_type* out, std::size_t n, const T min,
+                     const T delta, const T size) noexcept {
+  static const auto kernel = select_regular_index_n<T>();
+  kernel(x, out, n, min, delta, size);
+}
+
+} // namespace detail
+} // namespace histogram
+} // namespace boost
+
+#endif
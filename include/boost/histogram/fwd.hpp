@@ -14,6 +14,7 @@
 
 #include <boost/core/use_default.hpp>
 #include <boost/histogram/detail/attribute.hpp> // BOOST_HISTOGRAM_NODISCARD
+#include <cstddef>
 #include <vector>
 
 namespace boost {
@@ -38,6 +39,7 @@ struct null_type {};
 namespace transform {
 struct id;
 struct log;
+struct fast_log;
 struct sqrt;
 struct pow;
 } // namespace transform
@@ -46,13 +48,23 @@ template <class Value = double, class Transform = use_default,
           class MetaData = use_default, class Options = use_default>
 class regular;
 
+template <unsigned Bins, class Start, class Stop, class Value = double,
+          class MetaData = use_default, class Options = use_default>
+class static_regular;
+
 template <class Value = int, class MetaData = use_default, class Options = use_default>
 class integer;
 
+template <class Value = int, class MetaData = use_default, class Options = use_default>
+class integer_regular;
+
 template <class Value = double, class MetaData = use_default, class Options = use_default,
           class Allocator = std::allocator<Value>>
 class variable;
 
+template <class Value = double, class MetaData = use_default, class Options = use_default>
+class log_linear;
+
 template <class Value = int, class MetaData = use_default, class Options = use_default,
           class Allocator = std::allocator<Value>>
 class category;
@@ -96,9 +108,21 @@ struct unsafe_access;
 template <class Allocator = std::allocator<char>>
 class unlimited_storage;
 
+template <class Allocator = std::allocator<char>, std::size_t PageSize = 4096>
+class paged_unlimited_storage;
+
 template <class T>
 class storage_adaptor;
 
+template <class Storage>
+class sharded_storage;
+
+template <class Storage, std::size_t BufferSize = 64>
+class buffered_storage;
+
+template <class T = unsigned, unsigned Stripes = 0>
+class striped_storage;
+
 #endif // BOOST_HISTOGRAM_DOXYGEN_INVOKED
 
 /// Vector-like storage for fast zero-overhead access to cells.
@@ -10,6 +10,7 @@
 #include <boost/histogram/detail/axes.hpp>
 #include <boost/histogram/detail/common_type.hpp>
 #include <boost/histogram/detail/compressed_pair.hpp>
+#include <boost/histogram/detail/fill_n.hpp>
 #include <boost/histogram/detail/linearize.hpp>
 #include <boost/histogram/detail/noop_mutex.hpp>
 #include <boost/histogram/detail/static_if.hpp>
@@ -19,6 +20,7 @@
 #include <boost/mp11/list.hpp>
 #include <boost/throw_exception.hpp>
 #include <mutex>
+#include <shared_mutex>
 #include <stdexcept>
 #include <tuple>
 #include <type_traits>
@@ -182,8 +184,140 @@ public:
   /// Fill histogram with values, an optional weight, and/or a sample from a `std::tuple`.
   template <class... Ts>
   iterator operator()(const std::tuple<Ts...>& t) {
+    return detail::fill(storage_and_mutex_.second(), axes_, storage_and_mutex_.first(),
+                        t);
+  }
+
+  /** Fill histogram with a batch of values.
+
+    The values are passed as an iterable of columns, one column per axis. A column is a
+    contiguous sequence of values, like `std::vector` or `std::array`, or a
+    `boost::variant2::variant` of such sequences. All columns must have the same size. For
+    a one-dimensional histogram, a single column may also be passed directly.
+
+    Filling a batch of values gives the same result as calling the histogram with every
+    value in turn, but is considerably faster, since each column is processed in a tight
+    loop.
+
+    @param args iterable of columns, or a single column for one-dimensional histograms.
+  */
+  template <class Iterable, class = detail::requires_iterable<Iterable>>
+  void fill(const Iterable& args) {
+    std::lock_guard<mutex_type> guard{storage_and_mutex_.second()};
+    detail::fill_n(axes_, storage_and_mutex_.first(), args);
+  }
+
+  /** Fill histogram with a batch of values and weights.
+
+    The weights are passed as a contiguous sequence with the
+    [weight](boost/histogram/weight.html) helper function. The sequence must have the same
+    size as the columns of values.
+
+    @param args iterable of columns, or a single column for one-dimensional histograms.
+    @param weights sequence of weights marked with the weight helper function.
+  */
+  template <class Iterable, class T, class = detail::requires_iterable<Iterable>>
+  void fill(const Iterable& args, const weight_type<T>& weights) {
+    std::lock_guard<mutex_type> guard{storage_and_mutex_.second()};
+    detail::fill_n(axes_, storage_and_mutex_.first(), args, weights);
+  }
+
+  /** Fill histogram with a batch of values and samples.
+
+    The samples are passed as one or more contiguous sequences with the
+    [sample](boost/histogram/sample.html) helper function. Each sequence must have the
+    same size as the columns of values.
+
+    @param args iterable of columns, or a single column for one-dimensional histograms.
+    @param samples sequences of samples marked with the sample helper function.
+  */
+  template <class Iterable, class T, class = detail::requires_iterable<Iterable>>
+  void fill(const Iterable& args, const sample_type<T>& samples) {
+    std::lock_guard<mutex_type> guard{storage_and_mutex_.second()};
+    detail::fill_n(axes_, storage_and_mutex_.first(), args, samples);
+  }
+
+  /// Fill histogram with a batch of values, weights, and samples.
+  template <class Iterable, class T, class U,
+            class = detail::requires_iterable<Iterable>>
+  void fill(const Iterable& args, const weight_type<T>& weights,
+            const sample_type<U>& samples) {
+    std::lock_guard<mutex_type> guard{storage_and_mutex_.second()};
+    detail::fill_n(axes_, storage_and_mutex_.first(), args, weights, samples);
+  }
+
+  /// Fill histogram with a batch of values, samples, and weights.
+  template <class Iterable, class T, class U,
+            class = detail::requires_iterable<Iterable>>
+  void fill(const Iterable& args, const sample_type<T>& samples,
+            const weight_type<U>& weights) {
+    fill(args, weights, samples);
+  }
+
+  /** Fill histogram with a batch of values in parallel.
+
+    The batch is split into many more parts than there are threads in the executor, so
+    that the load is balanced if some threads are slower than others. Each thread fills
+    its parts into a separate partial storage, the partials are added to the histogram
+    afterwards. If the storage is a sharded_storage, each thread fills its shard instead.
+    The result is the same as for fill(args, ts...) up to round-off in the additions of
+    floating point cells. Histograms with growing axes are filled serially.
+
+    The executor must provide two methods. size() returns the number of threads. run(n,
+    f) calls f(i, t) for i in [0, n), possibly in parallel, and returns when all calls are
+    done. The second argument t must be the index of the calling thread in [0, size()),
+    and calls with the same t must not run concurrently.
+    [classref boost::histogram::thread_pool] is such an executor.
+
+    @param executor executor which runs the parallel tasks.
+    @param args iterable of columns, or a single column for one-dimensional histograms.
+    @param ts optional weights and/or samples, as for the serial fill.
+  */
+  template <class Executor, class Iterable, class... Ts,
+            class = detail::requires_executor<Executor>,
+            class = detail::requires_iterable<Iterable>>
+  void fill(Executor& executor, const Iterable& args, const Ts&... ts) {
     std::lock_guard<mutex_type> guard{storage_and_mutex_.second()};
-    return detail::fill(axes_, storage_and_mutex_.first(), t);
+    detail::fill_n_parallel(executor, axes_, storage_and_mutex_.first(), args, ts...);
+  }
+
+  /// Marks values which do not fall into any cell in the output of linearize.
+  static constexpr std::size_t invalid_index = detail::invalid_index;
+
+  /** Compute linear indices of the cells for a batch of values.
+
+    This is the first phase of fill, which computes the cell indices without incrementing
+    the cells. The indices can be passed to fill_linearized of this histogram or any other
+    histogram with equal axes, which is the second phase. This is faster than calling
+    fill for every histogram if several histograms with equal axes are filled with the
+    same values.
+
+    Values which do not fall into any cell give invalid_index. Growing axes are not grown,
+    values outside of their range are treated as for a non-growing axis.
+
+    @param args iterable of columns, or a single column for one-dimensional histograms.
+    @param out output iterator which receives one index per value.
+    @returns output iterator past the last written index.
+  */
+  template <class Iterable, class OutputIterator,
+            class = detail::requires_iterable<Iterable>>
+  OutputIterator linearize(const Iterable& args, OutputIterator out) const {
+    return detail::linearize_columns(axes_, args, out);
+  }
+
+  /** Increment cells at linear indices computed by linearize.
+
+    Indices equal to invalid_index are skipped. Optional weights and samples are passed
+    like for fill and must have the same size as the indices. Passing an index which is
+    out of bounds causes a throw of std::out_of_range before any cell is changed.
+
+    @param indices iterable of linear indices.
+    @param ts optional weights and/or samples.
+  */
+  template <class Iterable, class... Ts, class = detail::requires_iterable<Iterable>>
+  void fill_linearized(const Iterable& indices, const Ts&... ts) {
+    std::lock_guard<mutex_type> guard{storage_and_mutex_.second()};
+    detail::fill_linearized(storage_and_mutex_.first(), indices, ts...);
   }
 
   /** Access cell value at integral indices.
@@ -363,9 +497,10 @@ public:
 private:
   axes_type axes_;
 
+  // exclusive lock only for growing, see detail::fill
   using mutex_type = mp11::mp_if_c<(storage_type::has_threading_support &&
                                     detail::has_growing_axis<axes_type>::value),
-                                   std::mutex, detail::noop_mutex>;
+                                   std::shared_timed_mutex, detail::noop_mutex>;
 
   detail::compressed_pair<storage_type, mutex_type> storage_and_mutex_;
 
@@ -443,6 +578,9 @@ auto operator/(const histogram<A, S>& h, double x) {
   return h * (1.0 / x);
 }
 
+template <class A, class S>
+constexpr std::size_t histogram<A, S>::invalid_index;
+
 #if __cpp_deduction_guides >= 201606
 
 template <class Axes>
@@ -0,0 +1,212 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_PAGED_UNLIMITED_STORAGE_HPP
+#define BOOST_HISTOGRAM_PAGED_UNLIMITED_STORAGE_HPP
+
+#include <algorithm>
+#include <boost/histogram/detail/detect.hpp>
+#include <boost/histogram/detail/iterator_adaptor.hpp>
+#include <boost/histogram/detail/safe_comparison.hpp>
+#include <boost/histogram/fwd.hpp>
+#include <boost/histogram/unlimited_storage.hpp>
+#include <boost/mp11/list.hpp>
+#include <boost/mp11/utility.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+namespace boost {
+namespace histogram {
+
+/**
+  Memory-efficient storage for integral counters which cannot overflow, split in pages.
+
+  Works like unlimited_storage, but the cells are split into pages of PageSize cells and
+  each page has its own integral type. If an operation would overflow a counter, only
+  the page which holds the counter is replaced with one of a wider integral type. Thus
+  a few large counts widen a few pages instead of the whole storage, which is cheaper
+  for histograms with many cells, both in memory and in the time spent on copying. In
+  return, each access has to look up the page of the cell.
+
+  Cells are accessed through the proxy references of unlimited_storage. A scaling
+  operation converts all pages into doubles, like for unlimited_storage.
+
+  @tparam Allocator allocator to use for dynamic memory management.
+  @tparam PageSize number of cells per page, must be a power of two.
+*/
+template <class Allocator, std::size_t PageSize>
+class paged_unlimited_storage {
+  static_assert(PageSize > 0 && (PageSize & (PageSize - 1)) == 0,
+                "PageSize must be a power of two");
+
+  using base_type = unlimited_storage<Allocator>;
+
+public:
+  static constexpr bool has_threading_support = false;
+
+  using allocator_type = Allocator;
+  using value_type = double;
+  using large_int = typename base_type::large_int;
+  using buffer_type = typename base_type::buffer_type;
+  using reference = typename base_type::reference;
+  using const_reference = typename base_type::const_reference;
+
+private:
+  using page_allocator_type =
+      typename std::allocator_traits<allocator_type>::template rebind_alloc<buffer_type>;
+  using page_vector = std::vector<buffer_type, page_allocator_type>;
+
+  template <class Value, class Reference>
+  class iterator_impl : public detail::iterator_adaptor<iterator_impl<Value, Reference>,
+                                                        std::size_t, Reference, Value> {
+  public:
+    iterator_impl() = default;
+    template <class V, class R>
+    iterator_impl(const iterator_impl<V, R>& it)
+        : iterator_impl::iterator_adaptor_(it.base()), pages_(it.pages_) {}
+    iterator_impl(page_vector* p, std::size_t i) noexcept
+        : iterator_impl::iterator_adaptor_(i), pages_(p) {}
+
+    Reference operator*() const noexcept {
+      return {(*pages_)[this->base() / PageSize], this->base() % PageSize};
+    }
+
+    template <class V, class R>
+    friend class iterator_impl;
+
+  private:
+    mutable page_vector* pages_ = nullptr;
+  };
+
+public:
+  using const_iterator = iterator_impl<const value_type, const_reference>;
+  using iterator = iterator_impl<value_type, reference>;
+
+  explicit paged_unlimited_storage(const allocator_type& a = {})
+      : pages_(page_allocator_type(a)) {}
+  paged_unlimited_storage(const paged_unlimited_storage&) = default;
+  paged_unlimited_storage& operator=(const paged_unlimited_storage&) = default;
+  paged_unlimited_storage(paged_unlimited_storage&&) = default;
+  paged_unlimited_storage& operator=(paged_unlimited_storage&&) = default;
+
+  template <class Iterable, class = detail::requires_iterable<Iterable>>
+  explicit paged_unlimited_storage(const Iterable& s) {
+    using std::begin;
+    using std::end;
+    auto s_begin = begin(s);
+    using V = typename std::iterator_traits<decltype(s_begin)>::value_type;
+    constexpr auto ti = buffer_type::template type_index<V>();
+    constexpr auto nt = mp11::mp_size<typename buffer_type::types>::value;
+    using T = mp11::mp_if_c<(ti < nt), V, double>;
+    make_pages(static_cast<std::size_t>(std::distance(s_begin, end(s))),
+               [&s_begin](buffer_type& b, std::size_t n) {
+                 b.template make<T>(n, s_begin);
+                 std::advance(s_begin, n);
+               });
+  }
+
+  template <class Iterable, class = detail::requires_iterable<Iterable>>
+  paged_unlimited_storage& operator=(const Iterable& s) {
+    *this = paged_unlimited_storage(s);
+    return *this;
+  }
+
+  allocator_type get_allocator() const { return allocator_type(pages_.get_allocator()); }
+
+  void reset(std::size_t n) {
+    make_pages(n, [](buffer_type& b, std::size_t m) { b.template make<std::uint8_t>(m); });
+  }
+
+  std::size_t size() const noexcept {
+    return pages_.empty() ? 0 : (pages_.size() - 1) * PageSize + pages_.back().size;
+  }
+
+  reference operator[](std::size_t i) noexcept {
+    return {pages_[i / PageSize], i % PageSize};
+  }
+  const_reference operator[](std::size_t i) const noexcept {
+    return {pages_[i / PageSize], i % PageSize};
+  }
+
+  bool operator==(const paged_unlimited_storage& x) const noexcept {
+    if (size() != x.size()) return false;
+    auto xit = x.pages_.begin();
+    for (auto&& page : pages_) {
+      const bool equal = page.visit([&xit](const auto* p) {
+        return xit->visit([p, n = xit->size](const auto* xp) {
+          return std::equal(p, p + n, xp, detail::safe_equal{});
+        });
+      });
+      if (!equal) return false;
+      ++xit;
+    }
+    return true;
+  }
+
+  template <class Iterable>
+  bool operator==(const Iterable& iterable) const {
+    if (size() != iterable.size()) return false;
+    auto it = std::begin(iterable);
+    for (auto&& page : pages_) {
+      const bool equal = page.visit([&it, n = page.size](const auto* p) {
+        return std::equal(p, p + n, it, detail::safe_equal{});
+      });
+      if (!equal) return false;
+      std::advance(it, page.size);
+    }
+    return true;
+  }
+
+  paged_unlimited_storage& operator*=(const double x) {
+    for (auto&& page : pages_) {
+      // potential lossy conversion that cannot be avoided
+      if (page.type != buffer_type::template type_index<double>())
+        page.visit([&page](const auto* p) { page.template make<double>(page.size, p); });
+      auto p = static_cast<double*>(page.ptr);
+      for (auto end = p + page.size; p != end; ++p) *p *= x;
+    }
+    return *this;
+  }
+
+  iterator begin() noexcept { return {&pages_, 0}; }
+  iterator end() noexcept { return {&pages_, size()}; }
+  const_iterator begin() const noexcept { return {&pages_, 0}; }
+  const_iterator end() const noexcept { return {&pages_, size()}; }
+
+  /// implementation detail; used by unit tests, not part of generic storage interface
+  template <class T>
+  paged_unlimited_storage(std::size_t s, const T* p, const allocator_type& a = {})
+      : pages_(page_allocator_type(a)) {
+    make_pages(s, [&p](buffer_type& b, std::size_t n) {
+      b.template make<T>(n, p);
+      p += n;
+    });
+  }
+
+private:
+  // replaces the pages with pages for n cells, f(page, m) must make a page of m cells
+  template <class F>
+  void make_pages(std::size_t n, F&& f) {
+    page_vector pages(pages_.get_allocator());
+    pages.reserve((n + PageSize - 1) / PageSize);
+    for (std::size_t i = 0; i < n; i += PageSize) {
+      pages.emplace_back(get_allocator());
+      f(pages.back(), std::min(PageSize, n - i));
+    }
+    pages_ = std::move(pages);
+  }
+
+  mutable page_vector pages_;
+  friend struct unsafe_access;
+};
+
+} // namespace histogram
+} // namespace boost
+
+#endif
@@ -15,11 +15,18 @@
 #include <boost/histogram/accumulators/weighted_sum.hpp>
 #include <boost/histogram/axis/category.hpp>
 #include <boost/histogram/axis/integer.hpp>
+#include <boost/histogram/axis/integer_regular.hpp>
+#include <boost/histogram/axis/log_linear.hpp>
 #include <boost/histogram/axis/regular.hpp>
+#include <boost/histogram/axis/static_regular.hpp>
 #include <boost/histogram/axis/variable.hpp>
 #include <boost/histogram/axis/variant.hpp>
+#include <boost/histogram/buffered_storage.hpp>
 #include <boost/histogram/histogram.hpp>
+#include <boost/histogram/paged_unlimited_storage.hpp>
+#include <boost/histogram/sharded_storage.hpp>
 #include <boost/histogram/storage_adaptor.hpp>
+#include <boost/histogram/striped_storage.hpp>
 #include <boost/histogram/unlimited_storage.hpp>
 #include <boost/histogram/unsafe_access.hpp>
 #include <boost/mp11/algorithm.hpp>
@@ -34,6 +41,7 @@
 #include <boost/serialization/vector.hpp>
 #include <tuple>
 #include <type_traits>
+#include <vector>
 
 /**
   \file boost/histogram/serialization.hpp
@@ -105,6 +113,9 @@ void serialize(Archive&, id&, unsigned /* version */) {}
 template <class Archive>
 void serialize(Archive&, log&, unsigned /* version */) {}
 
+template <class Archive>
+void serialize(Archive&, fast_log&, unsigned /* version */) {}
+
 template <class Archive>
 void serialize(Archive&, sqrt&, unsigned /* version */) {}
 
@@ -127,6 +138,13 @@ void regular<T, Tr, M, O>::serialize(Archive& ar, unsigned /* version */) {
   ar& serialization::make_nvp("delta", delta_);
 }
 
+// parameters are part of the type
+template <unsigned B, class S, class T, class V, class M, class O>
+template <class Archive>
+void static_regular<B, S, T, V, M, O>::serialize(Archive& ar, unsigned /* version */) {
+  ar& serialization::make_nvp("meta", meta_);
+}
+
 template <class T, class M, class O>
 template <class Archive>
 void integer<T, M, O>::serialize(Archive& ar, unsigned /* version */) {
@@ -135,11 +153,38 @@ void integer<T, M, O>::serialize(Archive& ar, unsigned /* version */) {
   ar& serialization::make_nvp("min", min_);
 }
 
+template <class T, class M, class O>
+template <class Archive>
+void integer_regular<T, M, O>::serialize(Archive& ar, unsigned /* version */) {
+  auto width = this->width();
+  ar& serialization::make_nvp("size", size_meta_.first());
+  ar& serialization::make_nvp("meta", size_meta_.second());
+  ar& serialization::make_nvp("min", min_);
+  ar& serialization::make_nvp("width", width);
+  // divider is not serialized, it is rebuilt from the width
+  if (Archive::is_loading::value) {
+    span_ = static_cast<std::uint64_t>(size()) * width;
+    div_ = detail::fast_divider(width, span_ - 1);
+  }
+}
+
+template <class T, class M, class O>
+template <class Archive>
+void log_linear<T, M, O>::serialize(Archive& ar, unsigned /* version */) {
+  ar& serialization::make_nvp("size", size_meta_.first());
+  ar& serialization::make_nvp("meta", size_meta_.second());
+  ar& serialization::make_nvp("bits", bits_);
+  ar& serialization::make_nvp("min_key", min_key_);
+  if (Archive::is_loading::value) min_ = key_type::edge(min_key_, bits_);
+}
+
 template <class T, class M, class O, class A>
 template <class Archive>
 void variable<T, M, O, A>::serialize(Archive& ar, unsigned /* version */) {
   ar& serialization::make_nvp("seq", vec_meta_.first());
   ar& serialization::make_nvp("meta", vec_meta_.second());
+  // search index is not serialized, it is rebuilt from the edges
+  if (Archive::is_loading::value) rebuild_search();
 }
 
 template <class T, class M, class O, class A>
@@ -147,6 +192,8 @@ template <class Archive>
 void category<T, M, O, A>::serialize(Archive& ar, unsigned /* version */) {
   ar& serialization::make_nvp("seq", vec_meta_.first());
   ar& serialization::make_nvp("meta", vec_meta_.second());
+  // index is not serialized, it is rebuilt from the values
+  if (Archive::is_loading::value) rebuild_index();
 }
 
 // variant_proxy is a workaround to remain backward compatible in the serialization
@@ -228,9 +275,9 @@ void serialize(Archive& ar, storage_adaptor<T>& x, unsigned /* version */) {
   ar& serialization::make_nvp("impl", impl);
 }
 
-template <class Allocator, class Archive>
-void serialize(Archive& ar, unlimited_storage<Allocator>& s, unsigned /* version */) {
-  auto& buffer = unsafe_access::unlimited_storage_buffer(s);
+namespace detail {
+template <class Archive, class Buffer>
+void serialize_buffer(Archive& ar, Buffer& buffer) {
   using buffer_t = std::remove_reference_t<decltype(buffer)>;
   if (Archive::is_loading::value) {
     buffer_t helper(buffer.alloc);
@@ -253,6 +300,53 @@ void serialize(Archive& ar, unlimited_storage<Allocator>& s, unsigned /* version
         serialization::make_array(reinterpret_cast<T*>(buffer.ptr), buffer.size));
   });
 }
+} // namespace detail
+
+template <class Allocator, class Archive>
+void serialize(Archive& ar, unlimited_storage<Allocator>& s, unsigned /* version */) {
+  detail::serialize_buffer(ar, unsafe_access::unlimited_storage_buffer(s));
+}
+
+template <class Allocator, std::size_t PageSize, class Archive>
+void serialize(Archive& ar, paged_unlimited_storage<Allocator, PageSize>& s,
+               unsigned /* version */) {
+  auto& pages = unsafe_access::paged_unlimited_storage_pages(s);
+  std::size_t size = s.size();
+  ar& serialization::make_nvp("size", size);
+  if (Archive::is_loading::value) {
+    pages.clear();
+    pages.resize((size + PageSize - 1) / PageSize,
+                 typename paged_unlimited_storage<Allocator, PageSize>::buffer_type(
+                     s.get_allocator()));
+  }
+  // each page keeps its own type
+  for (auto&& page : pages) detail::serialize_buffer(ar, page);
+  BOOST_ASSERT(s.size() == size);
+}
+
+template <class Archive, class Storage>
+void serialize(Archive& ar, sharded_storage<Storage>& s, unsigned /* version */) {
+  // shards are merged before saving and reset when loading
+  s.flush();
+  ar& serialization::make_nvp("merged", unsafe_access::sharded_storage_merged(s));
+}
+
+template <class Archive, class Storage, std::size_t BufferSize>
+void serialize(Archive& ar, buffered_storage<Storage, BufferSize>& s,
+               unsigned /* version */) {
+  // buffers are flushed before saving and cleared when loading
+  s.flush();
+  ar& serialization::make_nvp("merged", unsafe_access::buffered_storage_merged(s));
+}
+
+template <class Archive, class T, unsigned Stripes>
+void serialize(Archive& ar, striped_storage<T, Stripes>& s, unsigned /* version */) {
+  // stripes are summed before saving, when loading the sums go into the first stripe
+  std::vector<T> buffer;
+  if (Archive::is_saving::value) buffer.assign(s.begin(), s.end());
+  ar& serialization::make_nvp("buffer", buffer);
+  if (Archive::is_loading::value) s = buffer;
+}
 
 template <class Archive, class A, class S>
 void serialize(Archive& ar, histogram<A, S>& h, unsigned /* version */) {
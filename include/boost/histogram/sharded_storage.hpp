@@ -0,0 +1,151 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_SHARDED_STORAGE_HPP
+#define BOOST_HISTOGRAM_SHARDED_STORAGE_HPP
+
+#include <boost/histogram/detail/detect.hpp>
+#include <boost/histogram/detail/make_default.hpp>
+#include <boost/histogram/detail/per_thread.hpp>
+#include <boost/histogram/fwd.hpp>
+#include <cstddef>
+#include <utility>
+
+namespace boost {
+namespace histogram {
+
+/** Storage which gives each filling thread a private copy of another storage.
+
+  Threads fill their private copy, called shard, without atomic operations and without
+  sharing cache lines with other threads, so that concurrent filling scales with the
+  number of threads also for histograms with few cells. The shards are added to a merged
+  copy of the storage whenever the cells are read, or explicitly with flush(). Reading
+  cells must therefore not happen concurrently with filling, and the filling threads
+  must be synchronized with the reading thread, for example by joining them.
+
+  The iterator returned by histogram::operator() points to the cell in the shard of the
+  calling thread.
+
+  @tparam Storage storage to be copied for each thread, must support `+=` of its cells.
+ */
+template <class Storage>
+class sharded_storage {
+public:
+  using storage_type = Storage;
+  using value_type = typename Storage::value_type;
+  using reference = typename Storage::reference;
+  using const_reference = typename Storage::const_reference;
+  using iterator = typename Storage::iterator;
+  using const_iterator = typename Storage::const_iterator;
+
+  static constexpr bool has_threading_support = true;
+
+  sharded_storage() = default;
+
+  explicit sharded_storage(const Storage& s) : merged_(s) {}
+  explicit sharded_storage(Storage&& s) : merged_(std::move(s)) {}
+
+  // copies contain only the merged cells
+  sharded_storage(const sharded_storage& o) : merged_((o.flush(), o.merged_)) {}
+
+  sharded_storage& operator=(const sharded_storage& o) {
+    if (this != &o) {
+      o.flush();
+      merged_ = o.merged_;
+      shards_.clear();
+    }
+    return *this;
+  }
+
+  sharded_storage(sharded_storage&&) = default;
+  sharded_storage& operator=(sharded_storage&&) = default;
+
+  void reset(std::size_t n) {
+    merged_.reset(n);
+    shards_.for_each([n](shard_type& s) {
+      s.storage.reset(n);
+      s.dirty = false;
+    });
+  }
+
+  std::size_t size() const noexcept { return merged_.size(); }
+
+  reference operator[](std::size_t i) {
+    flush();
+    return merged_[i];
+  }
+  const_reference operator[](std::size_t i) const {
+    flush();
+    return merged_[i];
+  }
+
+  bool operator==(const sharded_storage& o) const {
+    flush();
+    o.flush();
+    return merged_ == o.merged_;
+  }
+
+  template <class U, class = detail::requires_iterable<U>>
+  bool operator==(const U& u) const {
+    flush();
+    return merged_ == u;
+  }
+
+  sharded_storage& operator*=(const double x) {
+    flush();
+    merged_ *= x;
+    return *this;
+  }
+
+  iterator begin() {
+    flush();
+    return merged_.begin();
+  }
+  iterator end() { return merged_.end(); }
+  const_iterator begin() const {
+    flush();
+    return merged_.begin();
+  }
+  const_iterator end() const { return merged_.end(); }
+
+  /// Add all shards to the merged storage and reset them.
+  void flush() const {
+    shards_.for_each([this](shard_type& s) {
+      if (!s.dirty) return;
+      auto it = merged_.begin();
+      for (auto&& x : s.storage) *it++ += x;
+      s.storage.reset(merged_.size());
+      s.dirty = false;
+    });
+  }
+
+  /// Storage of the calling thread; the first call from a thread allocates it.
+  Storage& shard() {
+    auto& s = shards_.local([this] {
+      shard_type s{detail::make_default(merged_)};
+      s.storage.reset(merged_.size());
+      return s;
+    });
+    s.dirty = true;
+    return s.storage;
+  }
+
+private:
+  struct shard_type {
+    Storage storage;
+    bool dirty = false;
+  };
+
+  mutable Storage merged_;
+  mutable detail::per_thread<shard_type> shards_;
+
+  friend struct unsafe_access;
+};
+
+} // namespace histogram
+} // namespace boost
+
+#endif
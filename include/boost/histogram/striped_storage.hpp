@@ -0,0 +1,239 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_STRIPED_STORAGE_HPP
+#define BOOST_HISTOGRAM_STRIPED_STORAGE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <boost/histogram/accumulators/thread_safe.hpp>
+#include <boost/histogram/detail/iterator_adaptor.hpp>
+#include <boost/histogram/detail/operators.hpp>
+#include <boost/histogram/fwd.hpp>
+#include <cstddef>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace boost {
+namespace histogram {
+namespace detail {
+
+// number which is assigned round-robin to each thread on first call
+inline unsigned thread_number() noexcept {
+  static std::atomic<unsigned> counter{0};
+  static thread_local const unsigned n = counter++;
+  return n;
+}
+
+} // namespace detail
+
+/** Thread-safe storage of counters which are split into stripes to avoid false sharing.
+
+  In a dense storage of atomic counters, neighboring cells share a cache line. Threads
+  which increment neighboring cells on different CPU cores then compete for the same
+  cache line, although they never access the same cell. This storage keeps a separate
+  stripe of atomic counters for each of several threads. A thread always increments the
+  counters in its own stripe, and stripes are separated by at least one cache line, so
+  that threads with different stripes never share a cache line. The value of a cell is
+  the sum over all stripes, which is computed when the cell is read.
+
+  Threads are assigned to stripes round-robin in the order in which they first fill a
+  histogram. If there are more threads than stripes, some threads share a stripe, which
+  is still safe, because counters are atomic.
+
+  Reading cells is slower than for a dense storage, by a factor equal to the number of
+  stripes. Cells may be read while other threads fill, but the result is then only a
+  snapshot.
+
+  @tparam T integral or floating point type supported by std::atomic.
+  @tparam Stripes number of stripes, if zero the number of hardware threads is used.
+ */
+template <class T, unsigned Stripes>
+class striped_storage {
+  using counter_type = accumulators::thread_safe<T>;
+  using buffer_type = std::vector<counter_type>;
+
+  static constexpr std::size_t cache_line = 64;
+  static constexpr std::size_t line_size =
+      (cache_line + sizeof(counter_type) - 1) / sizeof(counter_type);
+
+public:
+  using value_type = T;
+  using const_reference = T;
+
+  /// implementation detail
+  class reference : detail::partially_ordered<reference, reference, void> {
+  public:
+    reference(striped_storage& s, std::size_t i) noexcept : s_(s), idx_(i) {}
+    reference(const reference&) noexcept = default;
+
+    // references do not rebind, assign through
+    reference& operator=(const reference& x) {
+      return operator=(static_cast<value_type>(x));
+    }
+
+    reference& operator=(const value_type x) {
+      s_.store(idx_, x);
+      return *this;
+    }
+
+    operator value_type() const noexcept { return s_.load(idx_); }
+
+    bool operator<(const reference& o) const noexcept {
+      return static_cast<value_type>(*this) < static_cast<value_type>(o);
+    }
+
+    bool operator==(const reference& o) const noexcept {
+      return static_cast<value_type>(*this) == static_cast<value_type>(o);
+    }
+
+    reference& operator+=(const value_type x) {
+      s_.local(idx_) += x;
+      return *this;
+    }
+
+    reference& operator++() {
+      ++s_.local(idx_);
+      return *this;
+    }
+
+  private:
+    striped_storage& s_;
+    std::size_t idx_;
+  };
+
+private:
+  template <class Value, class Reference, class Storage>
+  class iterator_impl
+      : public detail::iterator_adaptor<iterator_impl<Value, Reference, Storage>,
+                                        std::size_t, Reference, Value> {
+  public:
+    iterator_impl() = default;
+    template <class V, class R, class S>
+    iterator_impl(const iterator_impl<V, R, S>& it)
+        : iterator_impl::iterator_adaptor_(it.base()), storage_(it.storage_) {}
+    iterator_impl(Storage* s, std::size_t i) noexcept
+        : iterator_impl::iterator_adaptor_(i), storage_(s) {}
+
+    Reference operator*() const noexcept { return (*storage_)[this->base()]; }
+
+    template <class V, class R, class S>
+    friend class iterator_impl;
+
+  private:
+    Storage* storage_ = nullptr;
+  };
+
+public:
+  using iterator = iterator_impl<value_type, reference, striped_storage>;
+  using const_iterator =
+      iterator_impl<const value_type, const_reference, const striped_storage>;
+
+  /// Stripe of the calling thread, used by histogram to increment cells.
+  class stripe_type {
+  public:
+    using value_type = counter_type;
+    using iterator = typename striped_storage::iterator;
+
+    stripe_type(striped_storage& s, counter_type* p) noexcept : s_(s), ptr_(p) {}
+
+    counter_type& operator[](std::size_t i) noexcept { return ptr_[i]; }
+    iterator begin() noexcept { return s_.begin(); }
+
+  private:
+    striped_storage& s_;
+    counter_type* ptr_;
+  };
+
+  static constexpr bool has_threading_support = true;
+
+  striped_storage()
+      : stripes_(Stripes ? Stripes : std::max(std::thread::hardware_concurrency(), 1u)) {}
+
+  template <class Iterable, class = detail::requires_iterable<Iterable>>
+  explicit striped_storage(const Iterable& s) : striped_storage() {
+    using std::begin;
+    using std::end;
+    reset(static_cast<std::size_t>(std::distance(begin(s), end(s))));
+    std::size_t i = 0;
+    for (auto&& x : s) store(i++, static_cast<value_type>(x));
+  }
+
+  template <class Iterable, class = detail::requires_iterable<Iterable>>
+  striped_storage& operator=(const Iterable& s) {
+    *this = striped_storage(s);
+    return *this;
+  }
+
+  void reset(std::size_t n) {
+    size_ = n;
+    // stripes are at least one cache line apart, independent of the buffer alignment
+    stride_ = (n + 2 * line_size - 1) / line_size * line_size;
+    buffer_.clear();
+    buffer_.resize(stripes_ * stride_);
+  }
+
+  std::size_t size() const noexcept { return size_; }
+
+  /// Number of stripes.
+  unsigned stripes() const noexcept { return stripes_; }
+
+  reference operator[](std::size_t i) noexcept { return {*this, i}; }
+  const_reference operator[](std::size_t i) const noexcept { return load(i); }
+
+  bool operator==(const striped_storage& x) const noexcept {
+    if (size() != x.size()) return false;
+    for (std::size_t i = 0; i < size_; ++i)
+      if (load(i) != x.load(i)) return false;
+    return true;
+  }
+
+  template <class Iterable, class = detail::requires_iterable<Iterable>>
+  bool operator==(const Iterable& iterable) const {
+    if (size() != iterable.size()) return false;
+    return std::equal(begin(), end(), std::begin(iterable));
+  }
+
+  iterator begin() noexcept { return {this, 0}; }
+  iterator end() noexcept { return {this, size()}; }
+  const_iterator begin() const noexcept { return {this, 0}; }
+  const_iterator end() const noexcept { return {this, size()}; }
+
+  /// Stripe of the calling thread.
+  stripe_type shard() noexcept {
+    return {*this, buffer_.data() + detail::thread_number() % stripes_ * stride_};
+  }
+
+private:
+  counter_type& local(std::size_t i) noexcept {
+    return buffer_[detail::thread_number() % stripes_ * stride_ + i];
+  }
+
+  value_type load(std::size_t i) const noexcept {
+    value_type sum = 0;
+    for (std::size_t k = i; k < buffer_.size(); k += stride_)
+      sum += buffer_[k].load(std::memory_order_relaxed);
+    return sum;
+  }
+
+  void store(std::size_t i, value_type x) noexcept {
+    for (std::size_t k = i; k < buffer_.size(); k += stride_) {
+      buffer_[k] = x;
+      x = 0;
+    }
+  }
+
+  unsigned stripes_;
+  std::size_t size_ = 0;
+  std::size_t stride_ = 0;
+  buffer_type buffer_;
+};
+
+} // namespace histogram
+} // namespace boost
+
+#endif
@@ -0,0 +1,148 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_THREAD_POOL_HPP
+#define BOOST_HISTOGRAM_THREAD_POOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace boost {
+namespace histogram {
+
+/** Pool of threads which executes parallel loops, used by histogram::fill.
+
+  Any other type with the same two methods, size() and run(n, f), may be passed to
+  histogram::fill instead, to share an existing thread pool with the histogram.
+
+  Tasks are not assigned to threads in advance. Each thread takes the next task from a
+  shared atomic counter until all tasks are taken, so that threads which finish early
+  take over the remaining work of the others. This balances the load only if there are
+  many more tasks than threads, histogram::fill splits a batch accordingly.
+ */
+class thread_pool {
+public:
+  /** Start threads.
+
+    @param n number of threads which work on a loop, including the thread which calls
+    run, so that n - 1 threads are started. If n is zero, the number of hardware threads
+    is used.
+  */
+  explicit thread_pool(unsigned n = 0) {
+    if (n == 0) n = std::max(std::thread::hardware_concurrency(), 1u);
+    workers_.reserve(n - 1);
+    for (unsigned i = 1; i < n; ++i) workers_.emplace_back([this, i] { loop(i); });
+  }
+
+  thread_pool(const thread_pool&) = delete;
+  thread_pool& operator=(const thread_pool&) = delete;
+
+  ~thread_pool() {
+    {
+      std::lock_guard<std::mutex> lock{mutex_};
+      stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto&& t : workers_) t.join();
+  }
+
+  /// Number of threads which work on a loop.
+  std::size_t size() const noexcept { return workers_.size() + 1; }
+
+  /** Call f(i, t) for i in [0, n) in parallel and wait until all calls are done.
+
+    The second argument t is the index of the thread which executes the call, in [0,
+    size()). Calls with the same t never run concurrently. The calling thread takes part
+    in the work with index 0. If a call throws, the remaining tasks are still executed
+    and the first exception is rethrown.
+  */
+  template <class F>
+  void run(std::size_t n, F&& f) {
+    if (n == 0) return;
+    std::lock_guard<std::mutex> run_lock{run_mutex_};
+    const task_type g = std::ref(f);
+    {
+      std::lock_guard<std::mutex> lock{mutex_};
+      task_ = &g;
+      ntasks_ = n;
+      next_ = 0;
+      ndone_ = 0;
+      error_ = nullptr;
+      ++generation_;
+    }
+    wake_.notify_all();
+    work(g, n, 0);
+    std::unique_lock<std::mutex> lock{mutex_};
+    done_.wait(lock, [this] { return ndone_ == ntasks_ && nactive_ == 0; });
+    task_ = nullptr;
+    if (error_) std::rethrow_exception(error_);
+  }
+
+private:
+  using task_type = std::function<void(std::size_t, std::size_t)>;
+
+  void work(const task_type& f, const std::size_t n, const std::size_t t) {
+    for (std::size_t i; (i = next_++) < n;) {
+      try {
+        f(i, t);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock{mutex_};
+        if (!error_) error_ = std::current_exception();
+      }
+      if (++ndone_ == n) {
+        std::lock_guard<std::mutex> lock{mutex_};
+        done_.notify_all();
+      }
+    }
+  }
+
+  void loop(const std::size_t t) {
+    std::size_t generation = 0;
+    for (;;) {
+      const task_type* f;
+      std::size_t n;
+      {
+        std::unique_lock<std::mutex> lock{mutex_};
+        wake_.wait(lock, [&] { return stop_ || (generation_ != generation && task_); });
+        if (stop_) return;
+        generation = generation_;
+        f = task_;
+        n = ntasks_;
+        ++nactive_;
+      }
+      work(*f, n, t);
+      std::lock_guard<std::mutex> lock{mutex_};
+      // run must not return while a thread may still take tasks from the counter
+      if (--nactive_ == 0) done_.notify_all();
+    }
+  }
+
+  std::vector<std::thread> workers_;
+  std::mutex run_mutex_;
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable done_;
+  const task_type* task_ = nullptr;
+  std::size_t ntasks_ = 0;
+  std::size_t generation_ = 0;
+  std::size_t nactive_ = 0;
+  std::atomic<std::size_t> next_{0};
+  std::atomic<std::size_t> ndone_{0};
+  std::exception_ptr error_;
+  bool stop_ = false;
+};
+
+} // namespace histogram
+} // namespace boost
+
+#endif
@@ -8,6 +8,7 @@
 #define BOOST_HISTOGRAM_UNSAFE_ACCESS_HPP
 
 #include <boost/histogram/detail/axes.hpp>
+#include <cstddef>
 #include <type_traits>
 
 namespace boost {
@@ -87,6 +88,35 @@ struct unsafe_access {
     return storage.buffer_;
   }
 
+  /**
+    Get pages of paged_unlimited_storage.
+    @param storage instance of paged_unlimited_storage.
+  */
+  template <class Allocator, std::size_t PageSize>
+  static constexpr auto& paged_unlimited_storage_pages(
+      paged_unlimited_storage<Allocator, PageSize>& storage) {
+    return storage.pages_;
+  }
+
+  /**
+    Get merged storage of sharded_storage.
+    @param storage instance of sharded_storage.
+  */
+  template <class Storage>
+  static constexpr auto& sharded_storage_merged(sharded_storage<Storage>& storage) {
+    return storage.merged_;
+  }
+
+  /**
+    Get storage behind the buffers of buffered_storage.
+    @param storage instance of buffered_storage.
+  */
+  template <class Storage, std::size_t BufferSize>
+  static constexpr auto& buffered_storage_merged(
+      buffered_storage<Storage, BufferSize>& storage) {
+    return storage.merged_;
+  }
+
   /**
     Get implementation of storage_adaptor.
     @param storage instance of storage_adaptor.
@@ -7,11 +7,18 @@
 #include <boost/core/lightweight_test.hpp>
 #include <boost/histogram/axis/category.hpp>
 #include <boost/histogram/axis/ostream.hpp>
+#include <boost/histogram/axis/traits.hpp>
+#include <boost/histogram/axis/variant.hpp>
 #include <boost/histogram/detail/cat.hpp>
 #include <limits>
 #include <sstream>
 #include <string>
+#if __cpp_lib_string_view >= 201606
+#include <string_view>
+#endif
 #include <type_traits>
+#include <utility>
+#include <vector>
 #include "std_ostream.hpp"
 #include "throw_exception.hpp"
 #include "utility_axis.hpp"
@@ -82,6 +89,161 @@ int main() {
     BOOST_TEST_EQ(detail::cat(a), "category(5, 1, 10, options=growth)");
   }
 
+  // large axis with hash index
+  {
+    std::vector<int> v;
+    for (int i = 0; i < 1000; ++i) v.push_back(1024 * (i % 2 ? i : -i));
+    axis::category<int> a(v);
+    BOOST_TEST_EQ(a.size(), 1000);
+    for (int i = 0; i < 1000; ++i) BOOST_TEST_EQ(a.index(v[i]), i);
+    BOOST_TEST_EQ(a.index(1), 1000);
+    BOOST_TEST_EQ(a.index(1024 * 1000), 1000);
+
+    auto b = a;
+    BOOST_TEST_EQ(b, a);
+    for (int i = 0; i < 1000; ++i) BOOST_TEST_EQ(b.index(v[i]), i);
+    axis::category<int> c;
+    c = std::move(b);
+    for (int i = 0; i < 1000; ++i) BOOST_TEST_EQ(c.index(v[i]), i);
+
+    axis::category<std::string> d({"A", "B", "C"});
+    std::vector<std::string> s;
+    for (int i = 0; i < 100; ++i) s.push_back(std::to_string(i));
+    d = axis::category<std::string>(s);
+    for (int i = 0; i < 100; ++i) BOOST_TEST_EQ(d.index(s[i]), i);
+    BOOST_TEST_EQ(d.index("A"), 100);
+  }
+
+  // growth past the hash threshold keeps the bin order
+  {
+    axis::category<std::string, axis::null_type, axis::option::growth_t> a;
+    for (int i = 0; i < 1000; ++i)
+      BOOST_TEST_EQ(a.update(std::to_string(i)), std::make_pair(i, -1));
+    BOOST_TEST_EQ(a.size(), 1000);
+    for (int i = 0; i < 1000; ++i) {
+      BOOST_TEST_EQ(a.update(std::to_string(i)), std::make_pair(i, 0));
+      BOOST_TEST_EQ(a.value(i), std::to_string(i));
+    }
+    BOOST_TEST_EQ(a.index("foo"), 1000);
+  }
+
+  // fixed axis with perfect hash or lookup table
+  {
+    std::vector<long> v;
+    for (long i = 0; i < 1000; ++i) v.push_back(i * i * i - 500 * i);
+    axis::category<long> a(v);
+    for (int i = 0; i < 1000; ++i) BOOST_TEST_EQ(a.index(v[i]), i);
+    BOOST_TEST_EQ(a.index(1), 1000);
+    BOOST_TEST_EQ(a.index(-7), 1000);
+
+    // integers in a small range
+    axis::category<int> b({-3, 7, 2, 0});
+    BOOST_TEST_EQ(b.index(-3), 0);
+    BOOST_TEST_EQ(b.index(7), 1);
+    BOOST_TEST_EQ(b.index(0), 3);
+    BOOST_TEST_EQ(b.index(1), 4);
+    BOOST_TEST_EQ(b.index(8), 4);
+    BOOST_TEST_EQ(b.index(-4), 4);
+    BOOST_TEST_EQ(b.index(std::numeric_limits<int>::min()), 4);
+    BOOST_TEST_EQ(b.index(std::numeric_limits<int>::max()), 4);
+
+    axis::category<char> c({'a', 'z', 'Z'});
+    BOOST_TEST_EQ(c.index('z'), 1);
+    BOOST_TEST_EQ(c.index('b'), 3);
+
+    // first of several equal values is found, like with a linear search
+    std::vector<std::string> s;
+    for (int i = 0; i < 100; ++i) s.push_back(std::to_string(i % 50));
+    axis::category<std::string> d(s);
+    for (int i = 0; i < 100; ++i) BOOST_TEST_EQ(d.index(s[i]), i % 50);
+    BOOST_TEST_EQ(d.find("10"), 10);
+    BOOST_TEST_EQ(d.index("foo"), 100);
+
+    // axis which cannot grow is updated by hand
+    BOOST_TEST_EQ(d.update("foo"), std::make_pair(100, -1));
+    BOOST_TEST_EQ(d.index("foo"), 100);
+    BOOST_TEST_EQ(d.index("bar"), 101);
+
+    axis::variant<axis::category<long>, axis::category<std::string>> e = a;
+    for (int i = 0; i < 1000; ++i) BOOST_TEST_EQ(e.index(v[i]), i);
+    e = d;
+    BOOST_TEST_EQ(e.index("49"), 49);
+  }
+
+  // search order adapts to frequent values, indices are stable
+  {
+    using P = std::pair<int, int>; // has no std::hash
+    std::vector<P> v;
+    for (int i = 0; i < 200; ++i) v.emplace_back(i, -i);
+    axis::category<P, axis::null_type> a(v);
+    for (int k = 0; k < 2000; ++k) {
+      BOOST_TEST_EQ(a.index(v[199]), 199);
+      BOOST_TEST_EQ(a.index(v[k % 200]), k % 200);
+      BOOST_TEST_EQ(a.index(P(1, 1)), 200);
+    }
+    const auto b = a;
+    for (int i = 0; i < 200; ++i) BOOST_TEST_EQ(b.index(v[i]), i);
+
+    axis::category<P, axis::null_type, axis::option::growth_t> c;
+    for (int i = 0; i < 200; ++i) {
+      BOOST_TEST_EQ(c.update(v[i]), std::make_pair(i, -1));
+      for (int k = 0; k < 10; ++k) BOOST_TEST_EQ(c.index(v[i]), i);
+    }
+    for (int i = 0; i < 200; ++i) BOOST_TEST_EQ(c.update(v[i]), std::make_pair(i, 0));
+  }
+
+  // lookup without conversion
+  {
+    axis::category<std::string> a({"A", "B", "C"});
+    BOOST_TEST_EQ(a.find("B"), 1);
+    BOOST_TEST_EQ(a.find("D"), 3);
+    BOOST_TEST_EQ(axis::traits::index(a, "C"), 2);
+    const char* c = "C";
+    BOOST_TEST_EQ(axis::traits::index(a, c), 2);
+#if __cpp_lib_string_view >= 201606
+    BOOST_TEST_EQ(a.find(std::string_view("A")), 0);
+    BOOST_TEST_EQ(axis::traits::index(a, std::string_view("B")), 1);
+#endif
+
+    std::vector<std::string> s;
+    for (int i = 0; i < 100; ++i) s.push_back(std::to_string(i));
+    axis::category<std::string> b(s);
+    for (int i = 0; i < 100; ++i) BOOST_TEST_EQ(b.find(s[i].c_str()), i);
+    BOOST_TEST_EQ(b.find("A"), 100);
+
+    axis::category<std::string, axis::null_type, axis::option::growth_t> d;
+    for (int i = 0; i < 100; ++i) {
+      BOOST_TEST_EQ(d.emplace(s[i].c_str()), std::make_pair(i, -1));
+      BOOST_TEST_EQ(axis::traits::update(d, s[i].c_str()), std::make_pair(i, 0));
+    }
+    BOOST_TEST_EQ(axis::traits::update(d, "foo"), std::make_pair(100, -1));
+    BOOST_TEST_EQ(d.value(100), "foo");
+  }
+
+  // search with hint, and batch search of runs of equal values and random values
+  {
+    std::vector<std::string> s;
+    for (int i = 0; i < 20; ++i) s.push_back("host" + std::to_string(i));
+    const axis::category<std::string> a(s);
+    BOOST_TEST_EQ(a.index_near("host3", 3), 3);
+    BOOST_TEST_EQ(a.index_near("host3", 4), 3);
+    BOOST_TEST_EQ(a.index_near("host3", -1), 3);
+    BOOST_TEST_EQ(a.index_near("host3", 20), 3);
+    BOOST_TEST_EQ(a.index_near("foo", 3), 20);
+    BOOST_TEST_EQ(a.index_near("foo", 20), 20);
+
+    std::vector<std::string> runs, mixed;
+    for (int i = 0; i < 200; ++i) {
+      runs.push_back(i % 50 == 49 ? "foo" : s[(i / 8) % 20]);
+      mixed.push_back(i % 7 == 0 ? "foo" : s[(i * 13) % 20]);
+    }
+    for (auto&& x : {runs, mixed}) {
+      std::vector<axis::index_type> out(x.size());
+      a.index_n(x.data(), out.data(), x.size());
+      for (std::size_t k = 0; k < x.size(); ++k) BOOST_TEST_EQ(out[k], a.index(x[k]));
+    }
+  }
+
   // iterators
   {
     test_axis_iterator(axis::category<>({3, 1, 2}, ""), 0, 3);
@@ -0,0 +1,227 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/histogram/axis/integer_regular.hpp>
+#include <boost/histogram/axis/log_linear.hpp>
+#include <boost/histogram/axis/ostream.hpp>
+#include <boost/histogram/axis/variable.hpp>
+#include <boost/histogram/detail/cat.hpp>
+#include <boost/histogram/make_histogram.hpp>
+#include <boost/variant2/variant.hpp>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <ratio>
+#include <type_traits>
+#include <vector>
+#include "std_ostream.hpp"
+#include "throw_exception.hpp"
+#include "utility_axis.hpp"
+
+using namespace boost::histogram;
+using namespace std::chrono_literals;
+
+using ns = std::chrono::nanoseconds;
+using us = std::chrono::microseconds;
+using ms = std::chrono::milliseconds;
+using time_point = std::chrono::time_point<std::chrono::system_clock, ns>;
+
+// nanoseconds since epoch, which are not representable as double
+const time_point epoch{ns{1555555555123456789}};
+
+#if __cplusplus < 202002L
+namespace std {
+namespace chrono {
+// never add to std, we only do it here to print values in BOOST_TEST_EQ
+template <class R, class P>
+ostream& operator<<(ostream& os, const duration<R, P>& d) {
+  return os << d.count();
+}
+
+template <class C, class D>
+ostream& operator<<(ostream& os, const time_point<C, D>& t) {
+  return os << t.time_since_epoch().count();
+}
+} // namespace chrono
+} // namespace std
+#endif
+
+int main() {
+  // integer_regular
+  {
+    using A = axis::integer_regular<ns>;
+    BOOST_TEST(std::is_nothrow_move_assignable<A>::value);
+    A a{4, 0ns, 100ns, "foo"};
+    BOOST_TEST_EQ(a.size(), 4);
+    BOOST_TEST_EQ(a.width(), 25u);
+    BOOST_TEST((std::is_same<decltype(a.value(0)), ns>::value));
+    BOOST_TEST_EQ(a.value(0), 0ns);
+    BOOST_TEST_EQ(a.value(1), 25ns);
+    BOOST_TEST_EQ(a.value(-1), ns::min());
+    BOOST_TEST_EQ(a.value(5), ns::max());
+    BOOST_TEST_EQ(a.bin(1).lower(), 25ns);
+    BOOST_TEST_EQ(a.bin(1).upper(), 50ns);
+    BOOST_TEST_EQ(a.index(-1ns), -1);
+    BOOST_TEST_EQ(a.index(0ns), 0);
+    BOOST_TEST_EQ(a.index(24ns), 0);
+    BOOST_TEST_EQ(a.index(25ns), 1);
+    BOOST_TEST_EQ(a.index(99ns), 3);
+    BOOST_TEST_EQ(a.index(100ns), 4);
+    BOOST_TEST_EQ(detail::cat(a),
+                  "integer_regular(4, 0, 100, metadata=\"foo\", options=underflow | "
+                  "overflow)");
+    BOOST_TEST_EQ(detail::cat(a.bin(1)), "[25, 50)");
+
+    // step given in another duration, must be a multiple of the tick period
+    A b{axis::step(1ms), 0ns, 1s};
+    BOOST_TEST_EQ(b.size(), 1000);
+    BOOST_TEST_EQ(b.width(), 1000000u);
+    BOOST_TEST_EQ(b.index(1500us), 1);
+    BOOST_TEST_THROWS(A(axis::step(0ms), 0ns, 1s), std::invalid_argument);
+    BOOST_TEST_THROWS(A(axis::step(-1ms), 0ns, 1s), std::invalid_argument);
+    BOOST_TEST_THROWS(A(axis::step(std::chrono::duration<double, std::nano>(1.5)), 0ns,
+                        1s),
+                      std::invalid_argument);
+    BOOST_TEST_THROWS(A(axis::step(std::chrono::duration<int, std::ratio<1, 3>>(1)),
+                        0ns, 1s),
+                      std::invalid_argument);
+
+    // time points with more ticks than double can represent exactly
+    using B = axis::integer_regular<time_point>;
+    B c{axis::step(1ms), epoch, epoch + 1s};
+    BOOST_TEST_EQ(c.size(), 1000);
+    BOOST_TEST_EQ(c.value(0), epoch);
+    BOOST_TEST_EQ(c.value(3), epoch + 3ms);
+    BOOST_TEST_EQ(c.index(epoch - 1ns), -1);
+    BOOST_TEST_EQ(c.index(epoch), 0);
+    BOOST_TEST_EQ(c.index(epoch + 3ms - 1ns), 2);
+    BOOST_TEST_EQ(c.index(epoch + 3ms), 3);
+    BOOST_TEST_EQ(c.index(epoch + 1s), 1000);
+    BOOST_TEST_EQ(c, B(c, 0, 1000, 1));
+    BOOST_TEST_EQ(B(c, 2, 6, 2), B(2, epoch + 2ms, epoch + 6ms));
+
+    test_axis_iterator(A(5, 0ns, 10ns), 0, 5);
+  }
+
+  // log_linear
+  {
+    using A = axis::log_linear<us>;
+    A a{3, 1us, 1s};
+    axis::log_linear<us::rep> b{3, 1, 1000000};
+    BOOST_TEST_EQ(a.size(), b.size());
+    for (axis::index_type i = -1; i <= a.size() + 1; ++i)
+      BOOST_TEST_EQ(a.value(i).count(), b.value(i));
+    for (us::rep x = -1; x < 2000000; x += x / 3 + 1)
+      BOOST_TEST_EQ(a.index(us{x}), b.index(x));
+    BOOST_TEST_EQ(a.value(a.index(1024us)), 1024us);
+    BOOST_TEST_EQ(detail::cat(a),
+                  "log_linear(3, 1, 1048576, options=underflow | overflow)");
+
+    // floating point ticks
+    using fs = std::chrono::duration<double>;
+    axis::log_linear<fs> c{4, fs{1e-3}, fs{10}};
+    axis::log_linear<double> d{4, 1e-3, 10};
+    BOOST_TEST_EQ(c.size(), d.size());
+    for (axis::index_type i = 0; i <= c.size(); ++i)
+      BOOST_TEST_EQ(c.value(i).count(), d.value(i));
+    for (double x = 1e-4; x < 20; x *= 1.1) BOOST_TEST_EQ(c.index(fs{x}), d.index(x));
+
+    // time points
+    axis::log_linear<time_point> e{2, time_point{1us}, time_point{1s}};
+    axis::log_linear<ns::rep> f{2, 1000, 1000000000};
+    BOOST_TEST_EQ(e.size(), f.size());
+    for (axis::index_type i = 0; i <= e.size(); ++i) {
+      BOOST_TEST_EQ(e.value(i).time_since_epoch().count(), f.value(i));
+      BOOST_TEST_EQ(e.index(e.value(i)), i);
+      BOOST_TEST_EQ(e.index(e.value(i) - 1ns), i - 1);
+    }
+  }
+
+  // variable
+  {
+    using A = axis::variable<ns>;
+    BOOST_TEST(std::is_nothrow_move_assignable<A>::value);
+    A a{{-1000ms, 0ms, 1ms, 2ms, 10000ms}};
+    BOOST_TEST_EQ(a.size(), 4);
+    BOOST_TEST((std::is_same<decltype(a.value(0)), ns>::value));
+    BOOST_TEST_EQ(a.value(0), -1s);
+    BOOST_TEST_EQ(a.value(2), 1ms);
+    BOOST_TEST_EQ(a.value(4), 10s);
+    BOOST_TEST_EQ(a.value(2.5), 1500us);
+    BOOST_TEST_EQ(a.value(-1), ns::min());
+    BOOST_TEST_EQ(a.value(5), ns::max());
+    BOOST_TEST_EQ(a.index(-2s), -1);
+    BOOST_TEST_EQ(a.index(-1s), 0);
+    BOOST_TEST_EQ(a.index(-1ns), 0);
+    BOOST_TEST_EQ(a.index(0ns), 1);
+    BOOST_TEST_EQ(a.index(1ms - 1ns), 1);
+    BOOST_TEST_EQ(a.index(1ms), 2);
+    BOOST_TEST_EQ(a.index(10s), 4);
+    BOOST_TEST_EQ(a.index(ns::max()), 4);
+    BOOST_TEST_EQ(a.index_near(1500us, 3), 2);
+    BOOST_TEST_EQ(detail::cat(a),
+                  "variable(-1000000000, 0, 1000000, 2000000, 10000000000, "
+                  "options=underflow | overflow)");
+    BOOST_TEST_THROWS(A({0ns, 0ns}), std::invalid_argument);
+
+    // edges in coarser duration
+    const std::vector<ms> edges = {1ms, 2ms, 5ms};
+    BOOST_TEST_EQ(A(edges), A({1000000ns, 2000000ns, 5000000ns}));
+
+    // reduce
+    BOOST_TEST_EQ(A(a, 1, 3, 2), A({0ms, 2ms}));
+
+    // many edges use the grid or the eytzinger index, which must find the same bins
+    std::vector<time_point> v1, v2;
+    for (int i = 0; i < 100; ++i) {
+      v1.push_back(epoch + i * 1ms + (i % 3) * 1ns);
+      v2.push_back(epoch + 3 * ns{std::int64_t{1} << (i / 2)} + (i % 2) * 1ns);
+    }
+    for (auto&& v : {v1, v2}) {
+      const axis::variable<time_point> b(v);
+      std::vector<std::int64_t> t;
+      for (auto&& x : v) t.push_back(x.time_since_epoch().count());
+      std::vector<time_point> x;
+      for (auto&& vi : v) {
+        x.push_back(vi - 1ns);
+        x.push_back(vi);
+        x.push_back(vi + 1ns);
+      }
+      x.push_back(time_point::min());
+      x.push_back(time_point::max());
+      for (auto&& xi : x) {
+        const auto ti = xi.time_since_epoch().count();
+        const auto k = std::upper_bound(t.begin(), t.end(), ti) - t.begin() - 1;
+        BOOST_TEST_EQ(b.index(xi), k);
+        BOOST_TEST_EQ(b.index_near(xi, 50), k);
+      }
+      for (axis::index_type i = 0; i <= b.size(); ++i) BOOST_TEST_EQ(b.value(i), v[i]);
+    }
+
+    test_axis_iterator(A({0ns, 1ns, 2ns, 3ns}), 0, 3);
+  }
+
+  // histogram
+  {
+    auto h = make_histogram(axis::integer_regular<ns>(4, 0ns, 4ms),
+                            axis::variable<ms>({0ms, 1ms, 10ms}));
+    h(1500us, 3ms);
+    h(3ms, 20ms);
+    const std::vector<ns> x = {500us, 600us, 5ms};
+    const std::vector<ms> y = {0ms, 5ms, 5ms};
+    using col = boost::variant2::variant<std::vector<ns>, std::vector<ms>>;
+    h.fill(std::vector<col>{x, y});
+    BOOST_TEST_EQ(h.at(1, 1), 1);
+    BOOST_TEST_EQ(h.at(3, 2), 1);
+    BOOST_TEST_EQ(h.at(0, 0), 1);
+    BOOST_TEST_EQ(h.at(0, 1), 1);
+    BOOST_TEST_EQ(h.at(4, 1), 1);
+  }
+
+  return boost::report_errors();
+}
@@ -0,0 +1,32 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/assert.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/histogram/axis/integer_regular.hpp>
+#include <boost/histogram/axis/ostream.hpp>
+#include <boost/histogram/serialization.hpp>
+#include "throw_exception.hpp"
+#include "utility_serialization.hpp"
+
+using namespace boost::histogram;
+
+int main(int argc, char** argv) {
+  BOOST_ASSERT(argc == 2);
+
+  const auto filename = join(argv[1], "axis_integer_regular_serialization_test.xml");
+
+  axis::integer_regular<> a(7, -3, 18, "foo");
+  print_xml(filename, a);
+  axis::integer_regular<> b;
+  BOOST_TEST_NE(a, b);
+  load_xml(filename, b);
+  BOOST_TEST_EQ(a, b);
+  // divider is rebuilt from the bin width
+  for (int x = -4; x < 20; ++x) BOOST_TEST_EQ(b.index(x), a.index(x));
+
+  return boost::report_errors();
+}
@@ -0,0 +1,179 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/histogram/algorithm/reduce.hpp>
+#include <boost/histogram/axis/integer_regular.hpp>
+#include <boost/histogram/axis/ostream.hpp>
+#include <boost/histogram/detail/cat.hpp>
+#include <boost/histogram/make_histogram.hpp>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+#include "std_ostream.hpp"
+#include "throw_exception.hpp"
+#include "utility_axis.hpp"
+
+using namespace boost::histogram;
+
+// every bin edge is in its bin, the value just below it in the previous bin
+template <class A>
+void check_edges(const A& a) {
+  for (axis::index_type i = 0; i <= a.size(); ++i) {
+    const auto x = a.value(i);
+    BOOST_TEST_EQ(a.index(x), i);
+    if (x > std::numeric_limits<decltype(x)>::min()) BOOST_TEST_EQ(a.index(x - 1), i - 1);
+    if (i < a.size()) BOOST_TEST_EQ(a.index(a.value(i + 1) - 1), i);
+  }
+}
+
+int main() {
+  BOOST_TEST(std::is_nothrow_move_assignable<axis::integer_regular<>>::value);
+
+  // bad_ctor
+  {
+    BOOST_TEST_THROWS(axis::integer_regular<>(0, 0, 2), std::invalid_argument);
+    BOOST_TEST_THROWS(axis::integer_regular<>(1, 1, 1), std::invalid_argument);
+    BOOST_TEST_THROWS(axis::integer_regular<>(1, 2, 1), std::invalid_argument);
+    BOOST_TEST_THROWS(axis::integer_regular<>(3, 0, 10), std::invalid_argument);
+    BOOST_TEST_THROWS(axis::integer_regular<>(axis::step(0), 0, 10),
+                      std::invalid_argument);
+    BOOST_TEST_THROWS(axis::integer_regular<>(axis::step(-1), 0, 10),
+                      std::invalid_argument);
+    BOOST_TEST_THROWS(axis::integer_regular<>(axis::step(1.5), 0, 10),
+                      std::invalid_argument);
+    BOOST_TEST_THROWS(axis::integer_regular<>(axis::step(11), 0, 10),
+                      std::invalid_argument);
+    BOOST_TEST_THROWS(
+        axis::integer_regular<std::int64_t>(axis::step(1), 0,
+                                            std::numeric_limits<std::int64_t>::max()),
+        std::invalid_argument);
+  }
+
+  // axis::integer_regular
+  {
+    axis::integer_regular<> a{4, -2, 10, "foo"};
+    BOOST_TEST_EQ(a.metadata(), "foo");
+    a.metadata() = "bar";
+    BOOST_TEST_EQ(static_cast<const axis::integer_regular<>&>(a).metadata(), "bar");
+    BOOST_TEST_EQ(a.size(), 4);
+    BOOST_TEST_EQ(a.width(), 3u);
+    BOOST_TEST_EQ(a.value(0), -2);
+    BOOST_TEST_EQ(a.value(1), 1);
+    BOOST_TEST_EQ(a.value(4), 10);
+    BOOST_TEST_EQ(a.value(-1), std::numeric_limits<int>::min());
+    BOOST_TEST_EQ(a.value(5), std::numeric_limits<int>::max());
+    BOOST_TEST_EQ(a.bin(0).lower(), -2);
+    BOOST_TEST_EQ(a.bin(0).upper(), 1);
+    BOOST_TEST_EQ(a.bin(0).width(), 3);
+    BOOST_TEST_EQ(a.bin(1).center(), 2);
+    check_edges(a);
+
+    BOOST_TEST_EQ(a.index(std::numeric_limits<int>::min()), -1);
+    BOOST_TEST_EQ(a.index(-3), -1);
+    BOOST_TEST_EQ(a.index(-2), 0);
+    BOOST_TEST_EQ(a.index(0), 0);
+    BOOST_TEST_EQ(a.index(1), 1);
+    BOOST_TEST_EQ(a.index(9), 3);
+    BOOST_TEST_EQ(a.index(10), 4);
+    BOOST_TEST_EQ(a.index(std::numeric_limits<int>::max()), 4);
+
+    BOOST_TEST_EQ(detail::cat(a),
+                  "integer_regular(4, -2, 10, metadata=\"bar\", options=underflow | "
+                  "overflow)");
+
+    axis::integer_regular<> b;
+    BOOST_TEST_NE(a, b);
+    b = a;
+    BOOST_TEST_EQ(a, b);
+    axis::integer_regular<> c = std::move(b);
+    BOOST_TEST_EQ(c, a);
+    axis::integer_regular<> d;
+    BOOST_TEST_NE(c, d);
+    d = std::move(c);
+    BOOST_TEST_EQ(d, a);
+    BOOST_TEST_NE(a, axis::integer_regular<>(2, -2, 10, "bar"));
+    BOOST_TEST_NE(a, axis::integer_regular<>(4, -1, 11, "bar"));
+  }
+
+  // step
+  {
+    axis::integer_regular<unsigned> a{axis::step(10), 5, 39};
+    BOOST_TEST_EQ(a.size(), 3);
+    BOOST_TEST_EQ(a.value(0), 5u);
+    BOOST_TEST_EQ(a.value(3), 35u);
+    BOOST_TEST_EQ(a.index(34), 2);
+    BOOST_TEST_EQ(a.index(35), 3);
+    BOOST_TEST_EQ(a, (axis::integer_regular<unsigned>{3, 5, 35}));
+    check_edges(a);
+
+    // power of two width
+    axis::integer_regular<std::uint64_t> b{axis::step(std::uint64_t{1} << 20), 0,
+                                           std::uint64_t{1} << 40};
+    BOOST_TEST_EQ(b.size(), 1 << 20);
+    BOOST_TEST_EQ(b.index(0), 0);
+    BOOST_TEST_EQ(b.index((std::uint64_t{1} << 20) - 1), 0);
+    BOOST_TEST_EQ(b.index(std::uint64_t{1} << 20), 1);
+    BOOST_TEST_EQ(b.index(std::numeric_limits<std::uint64_t>::max()), b.size());
+  }
+
+  // full range of 64-bit types, nanoseconds from 1 us to 100 s in 1 ms bins
+  {
+    using I = std::int64_t;
+    axis::integer_regular<I> a{axis::step(1000000), 1000, 100000001000};
+    BOOST_TEST_EQ(a.size(), 100000);
+    check_edges(a);
+    for (I x = 0; x < 100000002000; x += x / 7 + 12345)
+      BOOST_TEST_EQ(a.index(x),
+                    x < 1000 ? -1 : std::min<I>((x - 1000) / 1000000, 100000));
+    BOOST_TEST_EQ(a.index(std::numeric_limits<I>::min()), -1);
+    BOOST_TEST_EQ(a.index(std::numeric_limits<I>::max()), a.size());
+
+    // range wider than 2^63
+    const auto lo = std::numeric_limits<I>::min() + 1;
+    const auto hi = std::numeric_limits<I>::max();
+    axis::integer_regular<I> b{7, lo, hi};
+    check_edges(b);
+    BOOST_TEST_EQ(b.width(), 2635249153387078802u);
+    BOOST_TEST_EQ(b.index(0), 3);
+    BOOST_TEST_EQ(b.index(lo - 1), -1);
+    BOOST_TEST_EQ(b.index(hi), b.size());
+
+    using U = std::uint64_t;
+    axis::integer_regular<U> c{5, 0, 15000000000000000000u};
+    check_edges(c);
+    BOOST_TEST_EQ(c.index(15000000000000000000u - 1), 4);
+  }
+
+  // reduce
+  {
+    using A = axis::integer_regular<int, axis::null_type>;
+    const auto a = A(6, 0, 12);
+    const auto b = A(a, 2, 6, 2);
+    BOOST_TEST_EQ(b, A(2, 4, 12));
+    const auto c = A(a, 0, 6, 3);
+    BOOST_TEST_EQ(c, A(2, 0, 12));
+    BOOST_TEST_EQ(c.width(), 6u);
+
+    auto h = make_histogram(a);
+    for (int x = -1; x < 13; ++x) h(x);
+    auto h2 = algorithm::reduce(h, algorithm::shrink_and_rebin(4, 11, 2));
+    BOOST_TEST_EQ(h2.axis(), A(2, 4, 12));
+    BOOST_TEST_EQ(h2.at(-1), 5);
+    BOOST_TEST_EQ(h2.at(0), 4);
+    BOOST_TEST_EQ(h2.at(1), 4);
+    BOOST_TEST_EQ(h2.at(2), 1);
+  }
+
+  // iterators
+  {
+    test_axis_iterator(axis::integer_regular<>(5, 0, 10), 0, 5);
+  }
+
+  return boost::report_errors();
+}
@@ -0,0 +1,34 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/assert.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/histogram/axis/log_linear.hpp>
+#include <boost/histogram/axis/ostream.hpp>
+#include <boost/histogram/serialization.hpp>
+#include "throw_exception.hpp"
+#include "utility_serialization.hpp"
+
+using namespace boost::histogram;
+
+int main(int argc, char** argv) {
+  BOOST_ASSERT(argc == 2);
+
+  const auto filename = join(argv[1], "axis_log_linear_serialization_test.xml");
+
+  axis::log_linear<> a(3, 1e-6, 100, "latency");
+  print_xml(filename, a);
+  axis::log_linear<> b;
+  BOOST_TEST_NE(a, b);
+  load_xml(filename, b);
+  BOOST_TEST_EQ(a, b);
+  // lower edge is rebuilt from the key
+  BOOST_TEST_EQ(b.value(0), a.value(0));
+  BOOST_TEST_EQ(b.index(1.0), a.index(1.0));
+  BOOST_TEST_EQ(b.index(a.value(0)), 0);
+
+  return boost::report_errors();
+}
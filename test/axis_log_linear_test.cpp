@@ -0,0 +1,218 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/core/lightweight_test.hpp>
+#include <boost/histogram/axis/log_linear.hpp>
+#include <boost/histogram/axis/ostream.hpp>
+#include <boost/histogram/detail/cat.hpp>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+#include "std_ostream.hpp"
+#include "throw_exception.hpp"
+#include "utility_axis.hpp"
+
+using namespace boost::histogram;
+
+template <class T>
+T below(T x, std::true_type) {
+  return x - 1;
+}
+
+template <class T>
+T below(T x, std::false_type) {
+  return std::nextafter(x, -std::numeric_limits<T>::infinity());
+}
+
+// every bin edge is in its bin, the value just below it in the previous bin
+template <class A>
+void check_edges(const A& a) {
+  using T = decltype(a.value(0));
+  for (axis::index_type i = 0; i <= a.size(); ++i) {
+    const auto x = a.value(i);
+    BOOST_TEST_EQ(a.index(x), i);
+    if (i > 0) {
+      BOOST_TEST_LT(a.value(i - 1), x);
+      BOOST_TEST_EQ(a.index(below(x, std::is_integral<T>{})), i - 1);
+    }
+  }
+}
+
+int main() {
+  BOOST_TEST(std::is_nothrow_move_assignable<axis::log_linear<>>::value);
+
+  // bad_ctor
+  {
+    BOOST_TEST_THROWS(axis::log_linear<>(2, 1, 1), std::invalid_argument);
+    BOOST_TEST_THROWS(axis::log_linear<>(2, 2, 1), std::invalid_argument);
+    BOOST_TEST_THROWS(axis::log_linear<>(2, -1, 1), std::invalid_argument);
+    BOOST_TEST_THROWS(axis::log_linear<>(2, 1, std::numeric_limits<double>::infinity()),
+                      std::invalid_argument);
+    BOOST_TEST_THROWS(axis::log_linear<>(53, 1, 2), std::invalid_argument);
+    BOOST_TEST_THROWS(axis::log_linear<>(30, 1, 1e10), std::invalid_argument);
+    BOOST_TEST_THROWS(axis::log_linear<int>(2, 1, std::numeric_limits<int>::max()),
+                      std::invalid_argument);
+  }
+
+  // axis::log_linear with double type
+  {
+    axis::log_linear<> a{2, 1, 8, "foo"};
+    BOOST_TEST_EQ(a.metadata(), "foo");
+    a.metadata() = "bar";
+    BOOST_TEST_EQ(static_cast<const axis::log_linear<>&>(a).metadata(), "bar");
+    BOOST_TEST_EQ(a.bits(), 2u);
+    BOOST_TEST_EQ(a.size(), 12);
+    const std::vector<double> edges = {1, 1.25, 1.5, 1.75, 2, 2.5, 3,
+                                       3.5, 4, 5, 6, 7, 8};
+    for (axis::index_type i = 0; i <= a.size(); ++i)
+      BOOST_TEST_EQ(a.value(i), edges[static_cast<std::size_t>(i)]);
+    BOOST_TEST_EQ(a.value(-1), -std::numeric_limits<double>::infinity());
+    BOOST_TEST_EQ(a.value(a.size() + 1), std::numeric_limits<double>::infinity());
+    BOOST_TEST_EQ(a.bin(-1).lower(), -std::numeric_limits<double>::infinity());
+    BOOST_TEST_EQ(a.bin(-1).upper(), 1);
+    BOOST_TEST_EQ(a.bin(5).lower(), 2.5);
+    BOOST_TEST_EQ(a.bin(5).upper(), 3);
+    BOOST_TEST_EQ(a.bin(5).center(), 2.75);
+    BOOST_TEST_EQ(a.bin(a.size()).upper(), std::numeric_limits<double>::infinity());
+
+    BOOST_TEST_EQ(a.index(-std::numeric_limits<double>::infinity()), -1);
+    BOOST_TEST_EQ(a.index(-1), -1);
+    BOOST_TEST_EQ(a.index(0), -1);
+    BOOST_TEST_EQ(a.index(-0.0), -1);
+    BOOST_TEST_EQ(a.index(0.99), -1);
+    BOOST_TEST_EQ(a.index(1), 0);
+    BOOST_TEST_EQ(a.index(1.3), 1);
+    BOOST_TEST_EQ(a.index(2.9), 5);
+    BOOST_TEST_EQ(a.index(7.99), 11);
+    BOOST_TEST_EQ(a.index(8), 12);
+    BOOST_TEST_EQ(a.index(1e300), 12);
+    BOOST_TEST_EQ(a.index(std::numeric_limits<double>::infinity()), 12);
+    BOOST_TEST_EQ(a.index(std::numeric_limits<double>::quiet_NaN()), 12);
+    BOOST_TEST_EQ(a.index(-std::numeric_limits<double>::quiet_NaN()), 12);
+
+    BOOST_TEST_EQ(detail::cat(a),
+                  "log_linear(2, 1, 8, metadata=\"bar\", options=underflow | overflow)");
+
+    axis::log_linear<> b;
+    BOOST_TEST_NE(a, b);
+    b = a;
+    BOOST_TEST_EQ(a, b);
+    axis::log_linear<> c = std::move(b);
+    BOOST_TEST_EQ(c, a);
+    axis::log_linear<> d;
+    BOOST_TEST_NE(c, d);
+    d = std::move(c);
+    BOOST_TEST_EQ(d, a);
+    BOOST_TEST_NE(a, axis::log_linear<>(3, 1, 8, "bar"));
+    BOOST_TEST_NE(a, axis::log_linear<>(2, 2, 8, "bar"));
+  }
+
+  // start and stop are rounded to bin edges
+  {
+    axis::log_linear<double, axis::null_type> a{2, 1.1, 5.5};
+    BOOST_TEST_EQ(a.value(0), 1);
+    BOOST_TEST_EQ(a.value(a.size()), 6);
+    BOOST_TEST_EQ(a.size(), 10);
+  }
+
+  // latency range from 1 microsecond to 100 seconds
+  {
+    axis::log_linear<double, axis::null_type> a{5, 1e-6, 100};
+    check_edges(a);
+    for (double x = 1e-6; x < 100; x *= 1.01) {
+      const auto i = a.index(x);
+      BOOST_TEST_LE(a.value(i), x);
+      BOOST_TEST_LT(x, a.value(i + 1));
+      BOOST_TEST_LT(a.value(i + 1) - a.value(i), x / 32 * 1.000001);
+    }
+    axis::log_linear<float, axis::null_type> b{5, 1e-6f, 100.f};
+    check_edges(b);
+    BOOST_TEST_EQ(a.size(), b.size());
+    for (double x = 1e-6; x < 100; x *= 1.01)
+      BOOST_TEST_EQ(b.index(static_cast<float>(x)), a.index(static_cast<float>(x)));
+  }
+
+  // floating point axis must start at a normal number
+  {
+    BOOST_TEST_THROWS(axis::log_linear<>(1, 0, 1), std::invalid_argument);
+    BOOST_TEST_THROWS(
+        axis::log_linear<>(1, std::numeric_limits<double>::denorm_min(), 1),
+        std::invalid_argument);
+    BOOST_TEST_THROWS(
+        axis::log_linear<float>(1, std::numeric_limits<float>::denorm_min(), 1),
+        std::invalid_argument);
+
+    axis::log_linear<double, axis::null_type> a{1, std::numeric_limits<double>::min(), 1};
+    BOOST_TEST_EQ(a.size(), 2044);
+    check_edges(a);
+    BOOST_TEST_EQ(a.index(0), -1);
+    BOOST_TEST_EQ(a.index(-0.0), -1);
+    BOOST_TEST_EQ(a.index(std::numeric_limits<double>::denorm_min()), -1);
+    BOOST_TEST_EQ(a.index(std::numeric_limits<double>::min()), 0);
+    BOOST_TEST_EQ(a.index(0.75), 2043);
+  }
+
+  // axis::log_linear with integral types
+  {
+    axis::log_linear<unsigned, axis::null_type> a{2, 0, 32};
+    // bins of unit width below 4
+    BOOST_TEST_EQ(a.size(), 16);
+    const std::vector<unsigned> edges = {0,  1,  2,  3,  4,  5,  6,  7, 8,
+                                         10, 12, 14, 16, 20, 24, 28, 32};
+    for (axis::index_type i = 0; i <= a.size(); ++i)
+      BOOST_TEST_EQ(a.value(i), edges[static_cast<std::size_t>(i)]);
+    check_edges(a);
+    BOOST_TEST_EQ(a.index(0), 0);
+    BOOST_TEST_EQ(a.index(9), 8);
+    BOOST_TEST_EQ(a.index(31), 15);
+    BOOST_TEST_EQ(a.index(32), 16);
+    BOOST_TEST_EQ(a.value(-1), 0u);
+    BOOST_TEST_EQ(a.value(a.size() + 1), std::numeric_limits<unsigned>::max());
+    BOOST_TEST_EQ(detail::cat(a), "log_linear(2, 0, 32, options=underflow | overflow)");
+
+    axis::log_linear<int, axis::null_type> b{3, 5, 1000};
+    check_edges(b);
+    BOOST_TEST_EQ(b.index(-5), -1);
+    BOOST_TEST_EQ(b.index(4), -1);
+    BOOST_TEST_EQ(b.index(5), 0);
+    BOOST_TEST_EQ(b.value(b.size()), 1024);
+    BOOST_TEST_EQ(b.index(1000), b.size() - 1);
+    BOOST_TEST_EQ(b.index(1024), b.size());
+    BOOST_TEST_EQ(b.index(std::numeric_limits<int>::max()), b.size());
+
+    // nanoseconds from 1 microsecond to 100 seconds
+    axis::log_linear<std::uint64_t, axis::null_type> c{5, 1000, 100000000000};
+    check_edges(c);
+    axis::log_linear<double, axis::null_type> d{5, 1000, 100000000000};
+    BOOST_TEST_EQ(c.size(), d.size());
+    for (std::uint64_t x = 1000; x < 100000000000; x += x / 97 + 1)
+      BOOST_TEST_EQ(c.index(x), d.index(static_cast<double>(x)));
+    BOOST_TEST_EQ(c.index(std::numeric_limits<std::uint64_t>::max()), c.size());
+  }
+
+  // shrink
+  {
+    using A = axis::log_linear<>;
+    auto a = A(2, 1, 8);
+    auto b = A(a, 2, 6, 1);
+    BOOST_TEST_EQ(b.size(), 4);
+    BOOST_TEST_EQ(b.value(0), 1.5);
+    BOOST_TEST_EQ(b.value(4), 3);
+    BOOST_TEST_EQ(b.index(1.4), -1);
+    BOOST_TEST_EQ(b.index(2.5), 3);
+    BOOST_TEST_EQ(b.index(3), 4);
+    BOOST_TEST_THROWS(A(a, 0, 4, 2), std::invalid_argument);
+  }
+
+  // iterators
+  {
+    test_axis_iterator(axis::log_linear<>(2, 1, 8), 0, 12);
+  }
+
+  return boost::report_errors();
+}
@@ -11,6 +11,8 @@
 #include <limits>
 #include <sstream>
 #include <type_traits>
+#include <utility>
+#include <vector>
 #include "is_close.hpp"
 #include "std_ostream.hpp"
 #include "throw_exception.hpp"
@@ -118,6 +120,59 @@ int main() {
     BOOST_TEST_EQ(detail::cat(a), "regular_log(2, 1, 100, options=underflow | overflow)");
   }
 
+  // with fast_log transform, bins are the same as with log transform
+  {
+    auto check = [](auto x) {
+      using T = decltype(x);
+      const auto inf = std::numeric_limits<T>::infinity();
+      for (auto n : {1u, 3u, 100u, 1000u}) {
+        const axis::regular<T, tr::log> a(n, 1e-6f, 1e3f);
+        const axis::regular<T, tr::fast_log> b(n, 1e-6f, 1e3f);
+        std::vector<T> v = {0, -1, inf, -inf, std::numeric_limits<T>::quiet_NaN(),
+                            std::numeric_limits<T>::denorm_min(),
+                            std::numeric_limits<T>::max()};
+        for (axis::index_type i = 0; i <= a.size(); ++i) {
+          const auto xi = static_cast<T>(a.value(i));
+          v.push_back(xi);
+          v.push_back(std::nextafter(xi, inf));
+          v.push_back(std::nextafter(xi, -inf));
+          v.push_back(std::nextafter(std::nextafter(xi, inf), inf));
+          v.push_back(std::nextafter(std::nextafter(xi, -inf), -inf));
+        }
+        for (T z = -16; z < 8; z += static_cast<T>(0.001)) v.push_back(std::exp(z));
+        std::vector<axis::index_type> out(v.size());
+        b.index_n(v.data(), out.data(), v.size());
+        for (std::size_t i = 0; i < v.size(); ++i) {
+          BOOST_TEST_EQ(b.index(v[i]), a.index(v[i]));
+          BOOST_TEST_EQ(out[i], a.index(v[i]));
+        }
+        for (axis::index_type i = -1; i <= a.size() + 1; ++i)
+          BOOST_TEST_EQ(b.value(i), a.value(i));
+      }
+    };
+    check(1.0);
+    check(1.0f);
+
+    axis::regular<double, tr::fast_log> a{2, 1e0, 1e2};
+    BOOST_TEST_EQ(detail::cat(a),
+                  "regular_fast_log(2, 1, 100, options=underflow | overflow)");
+    BOOST_TEST_EQ(a, a);
+    BOOST_TEST_THROWS((axis::regular<double, tr::fast_log>{2, -1, 0}),
+                      std::invalid_argument);
+
+    axis::regular<double, tr::fast_log, axis::null_type, axis::option::circular_t> c{
+        2, 1e0, 1e2};
+    BOOST_TEST_EQ(c.index(10), 1);
+    BOOST_TEST_EQ(c.index(1e3), 0);
+    BOOST_TEST_EQ(c.index(std::nextafter(1e4, 0.0)), 1);
+
+    axis::regular<double, tr::fast_log, axis::null_type, axis::option::growth_t> g{
+        2, 1e0, 1e2};
+    BOOST_TEST_EQ(g.update(10), std::make_pair(1, 0));
+    BOOST_TEST_EQ(g.update(1e3), std::make_pair(2, -1));
+    BOOST_TEST_EQ(g.size(), 3);
+  }
+
   // with sqrt transform
   {
     axis::regular<double, tr::sqrt> a(2, 0, 4);
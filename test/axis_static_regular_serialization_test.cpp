@@ -0,0 +1,34 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/assert.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/histogram/axis/static_regular.hpp>
+#include <boost/histogram/axis/ostream.hpp>
+#include <boost/histogram/serialization.hpp>
+#include <ratio>
+#include "throw_exception.hpp"
+#include "utility_serialization.hpp"
+
+using namespace boost::histogram;
+
+int main(int argc, char** argv) {
+  BOOST_ASSERT(argc == 2);
+
+  const auto filename = join(argv[1], "axis_static_regular_serialization_test.xml");
+
+  // bins and range are part of the type, only the metadata is stored
+  using A = axis::static_regular<10, std::ratio<-1>, std::ratio<1, 2>>;
+  A a("foo");
+  print_xml(filename, a);
+  A b;
+  BOOST_TEST_NE(a, b);
+  load_xml(filename, b);
+  BOOST_TEST_EQ(a, b);
+  BOOST_TEST_EQ(b.metadata(), "foo");
+
+  return boost::report_errors();
+}
@@ -0,0 +1,178 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/core/lightweight_test.hpp>
+#include <boost/histogram/axis/ostream.hpp>
+#include <boost/histogram/axis/regular.hpp>
+#include <boost/histogram/axis/static_regular.hpp>
+#include <boost/histogram/detail/cat.hpp>
+#include <boost/histogram/indexed.hpp>
+#include <boost/histogram/make_histogram.hpp>
+#include <limits>
+#include <ratio>
+#include <type_traits>
+#include <vector>
+#include "std_ostream.hpp"
+#include "throw_exception.hpp"
+#include "utility_axis.hpp"
+
+using namespace boost::histogram;
+
+// bins are the same as those of a regular axis
+template <class A, class B>
+void check_same_bins(const A& a, const B& b) {
+  using T = decltype(a.value(0));
+  const auto inf = std::numeric_limits<T>::infinity();
+  std::vector<T> x = {-inf, inf, std::numeric_limits<T>::quiet_NaN()};
+  for (axis::index_type i = -1; i <= a.size() + 1; ++i) {
+    BOOST_TEST_EQ(a.value(i), b.value(i));
+    const auto xi = a.value(i);
+    x.push_back(xi);
+    x.push_back(std::nextafter(xi, inf));
+    x.push_back(std::nextafter(xi, -inf));
+  }
+  std::vector<axis::index_type> out(x.size());
+  a.index_n(x.data(), out.data(), x.size());
+  for (std::size_t i = 0; i < x.size(); ++i) {
+    BOOST_TEST_EQ(a.index(x[i]), b.index(x[i]));
+    BOOST_TEST_EQ(out[i], b.index(x[i]));
+  }
+}
+
+int main() {
+  using one = std::ratio<1>;
+  using zero = std::ratio<0>;
+
+  // axis::static_regular
+  {
+    using A = axis::static_regular<4, std::ratio<-1>, std::ratio<3>>;
+    BOOST_TEST(std::is_nothrow_move_assignable<A>::value);
+    A a{"foo"};
+    BOOST_TEST_EQ(a.metadata(), "foo");
+    a.metadata() = "bar";
+    BOOST_TEST_EQ(static_cast<const A&>(a).metadata(), "bar");
+    BOOST_TEST_EQ(a.size(), 4);
+    BOOST_TEST_EQ(a.value(0), -1);
+    BOOST_TEST_EQ(a.value(1), 0);
+    BOOST_TEST_EQ(a.value(0.5), -0.5);
+    BOOST_TEST_EQ(a.value(4), 3);
+    BOOST_TEST_EQ(a.bin(-1).lower(), -std::numeric_limits<double>::infinity());
+    BOOST_TEST_EQ(a.bin(-1).upper(), -1);
+    BOOST_TEST_EQ(a.bin(2).lower(), 1);
+    BOOST_TEST_EQ(a.bin(2).upper(), 2);
+    BOOST_TEST_EQ(a.bin(4).upper(), std::numeric_limits<double>::infinity());
+
+    BOOST_TEST_EQ(a.index(-10), -1);
+    BOOST_TEST_EQ(a.index(-1), 0);
+    BOOST_TEST_EQ(a.index(-0.5), 0);
+    BOOST_TEST_EQ(a.index(0), 1);
+    BOOST_TEST_EQ(a.index(2.99), 3);
+    BOOST_TEST_EQ(a.index(3), 4);
+    BOOST_TEST_EQ(a.index(std::numeric_limits<double>::infinity()), 4);
+    BOOST_TEST_EQ(a.index(-std::numeric_limits<double>::infinity()), -1);
+    BOOST_TEST_EQ(a.index(std::numeric_limits<double>::quiet_NaN()), 4);
+
+    BOOST_TEST_EQ(detail::cat(a),
+                  "static_regular(4, -1, 3, metadata=\"bar\", options=underflow | "
+                  "overflow)");
+
+    A b;
+    BOOST_TEST_NE(a, b);
+    b = a;
+    BOOST_TEST_EQ(a, b);
+    A c = std::move(b);
+    BOOST_TEST_EQ(c, a);
+    BOOST_TEST_NE(a, (axis::static_regular<2, std::ratio<-1>, std::ratio<3>>("bar")));
+    BOOST_TEST_NE(a, (axis::static_regular<4, std::ratio<-1>, std::ratio<4>>("bar")));
+
+    // no per-instance parameters
+    BOOST_TEST_EQ(sizeof(axis::static_regular<4, zero, one, double, axis::null_type>),
+                  sizeof(axis::null_type));
+  }
+
+  // same bins as regular axis, if number of bins and width are powers of two
+  {
+    check_same_bins(axis::static_regular<128, std::ratio<-1>, one>{},
+                    axis::regular<>{128, -1, 1});
+    check_same_bins(axis::static_regular<16, std::ratio<1, 4>, std::ratio<17, 4>>{},
+                    axis::regular<>{16, 0.25, 4.25});
+    check_same_bins(axis::static_regular<64, zero, one, float>{},
+                    axis::regular<float>{64, 0, 1});
+  }
+
+  // other ranges and bins
+  {
+    axis::static_regular<10, std::ratio<1, 10>, std::ratio<11, 10>> a;
+    axis::regular<> b{10, 0.1, 1.1};
+    for (axis::index_type i = 0; i <= a.size(); ++i)
+      BOOST_TEST_LT(std::abs(a.value(i) - b.value(i)), 1e-15);
+    for (double x = 0; x < 1.2; x += 0.0123) {
+      const auto i = a.index(x);
+      BOOST_TEST_LE(i, b.index(x) + 1);
+      BOOST_TEST_GE(i, b.index(x) - 1);
+    }
+    for (axis::index_type i = 0; i < a.size(); ++i)
+      BOOST_TEST_EQ(a.index(a.bin(i).center()), i);
+
+    // integral constants
+    axis::static_regular<3, std::integral_constant<int, 2>,
+                         std::integral_constant<int, 5>>
+        c;
+    BOOST_TEST_EQ(c.value(0), 2);
+    BOOST_TEST_EQ(c.value(3), 5);
+    BOOST_TEST_EQ(c.index(3.5), 1);
+
+#if __cpp_nontype_template_args >= 201911L
+    axis::static_regular<4, axis::constant<0.5>, axis::constant<2.5>> d;
+    BOOST_TEST_EQ(d.value(0), 0.5);
+    BOOST_TEST_EQ(d.index(1), 1);
+#endif
+  }
+
+  // circular
+  {
+    axis::static_regular<4, zero, one, double, axis::null_type,
+                         decltype(axis::option::overflow | axis::option::circular)>
+        a;
+    BOOST_TEST_EQ(a.value(-1), -0.25);
+    BOOST_TEST_EQ(a.value(5), 1.25);
+    BOOST_TEST_EQ(a.index(-0.25), 3);
+    BOOST_TEST_EQ(a.index(0.5), 2);
+    BOOST_TEST_EQ(a.index(1.25), 1);
+    BOOST_TEST_EQ(a.index(std::numeric_limits<double>::infinity()), 4);
+    BOOST_TEST_EQ(a.index(std::numeric_limits<double>::quiet_NaN()), 4);
+    check_same_bins(a, axis::circular<>{4, 0, 1});
+  }
+
+  // iterators
+  {
+    test_axis_iterator(axis::static_regular<5, zero, one>(), 0, 5);
+  }
+
+  // histogram
+  {
+    using A = axis::static_regular<4, zero, one, double, axis::null_type>;
+    auto h = make_histogram(A{}, axis::regular<>(2, 0, 1));
+    h(0.1, 0.2);
+    h(0.6, 0.8);
+    h(2, 0.5);
+    const std::vector<double> x = {0.3, 0.35, -1};
+    h.fill(std::vector<std::vector<double>>{x, x});
+    BOOST_TEST_EQ(h.at(0, 0), 1);
+    BOOST_TEST_EQ(h.at(1, 0), 2);
+    BOOST_TEST_EQ(h.at(2, 1), 1);
+    BOOST_TEST_EQ(h.at(4, 1), 1);
+    BOOST_TEST_EQ(h.at(-1, -1), 1);
+    double sum = 0;
+    for (auto&& x : indexed(h)) {
+      BOOST_TEST_EQ(x.bin(0).lower(), 0.25 * x.index(0));
+      sum += *x;
+    }
+    BOOST_TEST_EQ(sum, 4);
+  }
+
+  return boost::report_errors();
+}
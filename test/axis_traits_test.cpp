@@ -90,6 +90,15 @@ int main() {
     auto a = integer<int, null_type, option::growth_t>();
     BOOST_TEST_EQ(traits::update(a, 0), (std::pair<index_type, index_type>(0, -1)));
     BOOST_TEST_THROWS(traits::update(a, "foo"), std::invalid_argument);
+
+    // axis with find but without emplace is updated with update
+    struct growing_with_find {
+      index_type index(double) const { return 0; }
+      std::pair<index_type, index_type> update(double) { return {1, 0}; }
+      index_type find(double) const { return 0; }
+    };
+    auto b = growing_with_find{};
+    BOOST_TEST_EQ(traits::update(b, 1.0), (std::pair<index_type, index_type>(1, 0)));
   }
 
   // metadata
@@ -4,10 +4,12 @@
 // (See accompanying file LICENSE_1_0.txt
 // or copy at http://www.boost.org/LICENSE_1_0.txt)
 
+#include <algorithm>
 #include <boost/core/lightweight_test.hpp>
 #include <boost/histogram/axis/ostream.hpp>
 #include <boost/histogram/axis/variable.hpp>
 #include <boost/histogram/detail/cat.hpp>
+#include <cmath>
 #include <limits>
 #include <type_traits>
 #include <vector>
@@ -119,6 +121,112 @@ int main() {
                   std::make_pair(a.size(), 0));
   }
 
+  // bin search agrees with std::upper_bound for short and long edge sequences, which
+  // are regular, almost regular, or irregular
+  {
+    auto check = [](auto x) {
+      using T = decltype(x);
+      const auto inf = std::numeric_limits<T>::infinity();
+      auto check_edges = [inf](const std::vector<T>& v) {
+        const axis::variable<T, axis::null_type> a(v);
+        std::vector<T> xs = {-inf, inf, std::numeric_limits<T>::quiet_NaN(), 0, -0.0f};
+        for (auto&& vi : v) {
+          xs.push_back(vi);
+          xs.push_back(std::nextafter(vi, -inf));
+          xs.push_back(std::nextafter(vi, inf));
+        }
+        for (T z = -1; z < 2; z += static_cast<T>(0.001)) xs.push_back(z * v.back());
+        const int n = static_cast<int>(v.size());
+        for (auto&& xi : xs) {
+          const auto i = std::upper_bound(v.begin(), v.end(), xi) - v.begin() - 1;
+          BOOST_TEST_EQ(a.index(xi), i);
+          for (int hint : {-5, -1, 0, 1, n / 2, n - 2, n - 1, n, n + 5}) {
+            BOOST_TEST_EQ(a.index_near(xi, hint), i);
+            BOOST_TEST_EQ(a.index_near(xi, static_cast<axis::index_type>(i) + 1), i);
+          }
+        }
+        // sorted values are found by galloping, unsorted values are not
+        std::vector<axis::index_type> out(xs.size());
+        for (int sorted = 0; sorted < 2; ++sorted) {
+          if (sorted) std::sort(xs.begin(), xs.end());
+          a.index_n(xs.data(), out.data(), xs.size());
+          for (std::size_t k = 0; k < xs.size(); ++k) BOOST_TEST_EQ(out[k], a.index(xs[k]));
+        }
+      };
+      for (int n : {2, 3, 5, 8, 16, 23, 24, 25, 31, 32, 33, 100, 1000, 1023, 1024}) {
+        std::vector<T> v;
+        for (int i = 0; i < n; ++i) v.push_back(static_cast<T>(10 * i) / n - 1);
+        check_edges(v);
+        auto w = v;
+        for (auto&& wi : w) wi = std::exp(wi);
+        check_edges(w);
+        // pairs of close edges
+        w.clear();
+        for (auto&& vi : v) {
+          w.push_back(vi);
+          w.push_back(vi + static_cast<T>(0.01) / n);
+        }
+        check_edges(w);
+        for (auto&& vi : v) vi = vi * vi * vi;
+        check_edges(v);
+        v.push_back(1000);
+        check_edges(v);
+      }
+    };
+    check(1.0);
+    check(1.0f);
+  }
+
+  // long axis with edge at infinity, which grows, is copied, and is shrunk
+  {
+    const auto inf = std::numeric_limits<double>::infinity();
+    std::vector<double> v;
+    for (int i = 0; i < 100; ++i) v.push_back(i);
+    v.push_back(inf);
+    axis::variable<double, axis::null_type> a(v);
+    BOOST_TEST_EQ(a.index(99.5), 99);
+    BOOST_TEST_EQ(a.index(1e300), 99);
+    BOOST_TEST_EQ(a.index(inf), 100);
+    BOOST_TEST_EQ(a.index(std::numeric_limits<double>::quiet_NaN()), 100);
+
+    axis::variable<double, axis::null_type, axis::option::growth_t> b(
+        v.begin(), v.end() - 1);
+    BOOST_TEST_EQ(b.update(-2.5), std::make_pair(0, 1));
+    BOOST_TEST_EQ(b.size(), 100);
+    BOOST_TEST_EQ(b.index(-2.5), 0);
+    BOOST_TEST_EQ(b.index(0), 1);
+    BOOST_TEST_EQ(b.update(100.5), std::make_pair(100, -1));
+    BOOST_TEST_EQ(b.size(), 101);
+    BOOST_TEST_EQ(b.index(99), 100);
+    BOOST_TEST_EQ(b.index(100.5), 100);
+    BOOST_TEST_EQ(b.index(1000), 101);
+
+    auto c = b;
+    BOOST_TEST_EQ(c.index(50.5), 51);
+    const auto d = std::move(c);
+    BOOST_TEST_EQ(d.index(50.5), 51);
+
+    const axis::variable<double, axis::null_type> e(a, 10, 90, 2);
+    BOOST_TEST_EQ(e.size(), 40);
+    BOOST_TEST_EQ(e.index(9), -1);
+    BOOST_TEST_EQ(e.index(13), 1);
+    BOOST_TEST_EQ(e.index(90), 40);
+
+    axis::variable<double, axis::null_type, axis::option::circular_t> f(v.begin(),
+                                                                       v.end() - 1);
+    BOOST_TEST_EQ(f.index(99), 0);
+    BOOST_TEST_EQ(f.index(-0.5), 98);
+    BOOST_TEST_EQ(f.index_near(-0.5, 0), 98);
+    BOOST_TEST_EQ(f.index_near(199.5, 98), 1);
+
+    // slow walk which wraps around the circular axis
+    std::vector<double> xs;
+    for (int i = 0; i < 1000; ++i) xs.push_back(0.37 * i - 100);
+    std::vector<axis::index_type> out(xs.size());
+    f.index_n(xs.data(), out.data(), xs.size());
+    for (std::size_t k = 0; k < xs.size(); ++k) BOOST_TEST_EQ(out[k], f.index(xs[k]));
+  }
+
   // iterators
   {
     test_axis_iterator(axis::variable<>{1, 2, 3}, 0, 2);
@@ -0,0 +1,91 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/histogram/accumulators/ostream.hpp>
+#include <boost/histogram/accumulators/thread_safe.hpp>
+#include <boost/histogram/axis/integer.hpp>
+#include <boost/histogram/axis/ostream.hpp>
+#include <boost/histogram/buffered_storage.hpp>
+#include <boost/histogram/indexed.hpp>
+#include <boost/histogram/make_histogram.hpp>
+#include <boost/histogram/ostream.hpp>
+#include <boost/histogram/storage_adaptor.hpp>
+#include <random>
+#include <vector>
+#include "throw_exception.hpp"
+#include "utility_histogram.hpp"
+#include "utility_threaded.hpp"
+
+using namespace boost::histogram;
+
+constexpr auto n_fill = 400000;
+
+using ts_storage = dense_storage<accumulators::thread_safe<unsigned>>;
+
+template <class Tag, class Storage, class A1, class A2, class X, class Y>
+void fill_test(const A1& a1, const A2& a2, const X& x, const Y& y) {
+  threaded_fill_test<Tag, Storage>(a1, a2, x, y, [](auto& s) { s.flush(); });
+}
+
+template <class Tag>
+void tests() {
+  std::mt19937 gen(1);
+  // skewed distribution, most values hit few cells
+  std::geometric_distribution<> id(0.3);
+  std::vector<int> vi(n_fill), vj(n_fill);
+  std::generate(vi.begin(), vi.end(), [&] { return id(gen); });
+  std::generate(vj.begin(), vj.end(), [&] { return id(gen); });
+
+  using i = axis::integer<>;
+  using ig = axis::integer<int, use_default, axis::option::growth_t>;
+  fill_test<Tag, buffered_storage<ts_storage>>(i{0, 20}, i{0, 20}, vi, vj);
+  fill_test<Tag, buffered_storage<ts_storage, 1>>(i{0, 20}, i{0, 20}, vi, vj);
+  fill_test<Tag, buffered_storage<ts_storage, 8>>(ig{0, 1}, i{0, 5}, vi, vj);
+  fill_test<Tag, buffered_storage<ts_storage>>(i{0, 5}, ig{0, 1}, vi, vj);
+}
+
+int main() {
+  // works with make_histogram_with
+  {
+    auto h =
+        make_histogram_with(buffered_storage<ts_storage>(), axis::integer<>(0, 3));
+    h(0);
+    h(1);
+    h(1);
+    BOOST_TEST_EQ(h.at(1), 2);
+    h(1);
+    BOOST_TEST_EQ(h.at(1), 3);
+  }
+
+  // moved storage keeps the buffered increments
+  {
+    auto h =
+        make_histogram_with(buffered_storage<ts_storage>(), axis::integer<>(0, 3));
+    run_in_threads([&h](int k) { h(k % 2); });
+    h(1);
+    auto h2 = std::move(h);
+    BOOST_TEST_EQ(h2.at(0), 2);
+    BOOST_TEST_EQ(h2.at(1), 3);
+    h2(1);
+    BOOST_TEST_EQ(h2.at(1), 4);
+
+    auto h3 =
+        make_histogram_with(buffered_storage<ts_storage>(), axis::integer<>(0, 3));
+    h3(2);
+    h3 = std::move(h2);
+    h3(0);
+    BOOST_TEST_EQ(h3.at(0), 3);
+    BOOST_TEST_EQ(h3.at(1), 4);
+    BOOST_TEST_EQ(h3.at(2), 0);
+  }
+
+  tests<static_tag>();
+  tests<dynamic_tag>();
+
+  return boost::report_errors();
+}
@@ -14,6 +14,8 @@
 #include <boost/histogram/ostream.hpp>
 #include <boost/histogram/storage_adaptor.hpp>
 #include <boost/histogram/unlimited_storage.hpp>
+#include <chrono>
+#include <cstdint>
 #include <tuple>
 #include <type_traits>
 #include <vector>
@@ -61,6 +63,41 @@ int main() {
     BOOST_TEST_TRAIT_SAME(decltype(f), axis::integer<int, axis::null_type>);
   }
 
+  {
+    axis::log_linear a(2, 1.0, 8.0);
+    axis::log_linear b(2, 1.0f, 8.0f);
+    axis::log_linear c(2, 1u, 8u, "foo");
+    axis::log_linear d(2, 1, 8, axis::null_type{});
+
+    BOOST_TEST_TRAIT_SAME(decltype(a), axis::log_linear<>);
+    BOOST_TEST_TRAIT_SAME(decltype(b), axis::log_linear<float>);
+    BOOST_TEST_TRAIT_SAME(decltype(c), axis::log_linear<unsigned>);
+    BOOST_TEST_TRAIT_SAME(decltype(d), axis::log_linear<int, axis::null_type>);
+  }
+
+  {
+    axis::integer_regular a(2, 1, 9);
+    axis::integer_regular b(2, 1u, 9u, "foo");
+    axis::integer_regular c(2, std::int64_t{1}, std::int64_t{9}, axis::null_type{});
+
+    BOOST_TEST_TRAIT_SAME(decltype(a), axis::integer_regular<>);
+    BOOST_TEST_TRAIT_SAME(decltype(b), axis::integer_regular<unsigned>);
+    BOOST_TEST_TRAIT_SAME(decltype(c),
+                          axis::integer_regular<std::int64_t, axis::null_type>);
+  }
+
+  {
+    using std::chrono::milliseconds;
+    using std::chrono::nanoseconds;
+    axis::integer_regular a(2, nanoseconds{0}, nanoseconds{10});
+    axis::log_linear b(2, milliseconds{1}, milliseconds{8}, "foo");
+    axis::variable c{milliseconds{1}, milliseconds{2}};
+
+    BOOST_TEST_TRAIT_SAME(decltype(a), axis::integer_regular<nanoseconds>);
+    BOOST_TEST_TRAIT_SAME(decltype(b), axis::log_linear<milliseconds>);
+    BOOST_TEST_TRAIT_SAME(decltype(c), axis::variable<milliseconds>);
+  }
+
   {
     axis::variable a{-1, 1};
     axis::variable b{-1.f, 1.f};
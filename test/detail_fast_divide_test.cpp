@@ -0,0 +1,59 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/core/lightweight_test.hpp>
+#include <boost/histogram/detail/fast_divide.hpp>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+#include "std_ostream.hpp"
+
+using namespace boost::histogram::detail;
+
+// quotients are exact for numerators up to the limit
+void check(std::uint64_t d, std::uint64_t limit) {
+  const fast_divider f(d, limit);
+  BOOST_TEST_EQ(f.divisor(), d);
+  std::vector<std::uint64_t> x = {0, 1, d - 1, d, d + 1, limit - 1, limit};
+  // numerators near multiples of d have the largest error before truncation
+  const std::uint64_t n = limit / d;
+  for (std::uint64_t k : std::vector<std::uint64_t>{2, 3, 1000, n - 1, n}) {
+    if (k == 0 || k > n) continue;
+    x.push_back(k * d);
+    x.push_back(k * d - 1);
+  }
+  std::mt19937_64 gen(d);
+  std::uniform_int_distribution<std::uint64_t> dist(0, limit);
+  for (int i = 0; i < 1000; ++i) x.push_back(dist(gen));
+  for (auto xi : x)
+    if (xi <= limit) BOOST_TEST_EQ(f(xi), xi / d);
+}
+
+int main() {
+  BOOST_TEST_EQ(highest_bit(1), 0u);
+  BOOST_TEST_EQ(highest_bit(2), 1u);
+  BOOST_TEST_EQ(highest_bit(3), 1u);
+  BOOST_TEST_EQ(highest_bit(1000), 9u);
+  BOOST_TEST_EQ(highest_bit(std::numeric_limits<std::uint64_t>::max()), 63u);
+
+  const auto max = std::numeric_limits<std::uint64_t>::max();
+  const auto one = std::uint64_t{1};
+  const auto max63 = (one << 63) - 1;
+  for (std::uint64_t d = 1; d < 300; ++d) {
+    check(d, 100000);
+    check(d, max63);
+    check(d, max);
+  }
+  for (std::uint64_t d : std::vector<std::uint64_t>{1000, 1000000007, 3 * (one << 40),
+                                                    (one << 62) + 1, max63, one << 63,
+                                                    (one << 63) + 1, max}) {
+    check(d, max63);
+    check(d, max);
+  }
+
+  return boost::report_errors();
+}
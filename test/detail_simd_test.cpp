@@ -0,0 +1,137 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/core/lightweight_test.hpp>
+#include <boost/histogram/axis/regular.hpp>
+#include <boost/histogram/detail/simd.hpp>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include "throw_exception.hpp"
+
+using namespace boost::histogram;
+
+template <class T>
+std::vector<T> make_input(const axis::regular<T>& a) {
+  const auto inf = std::numeric_limits<T>::infinity();
+  const auto nan = std::numeric_limits<T>::quiet_NaN();
+  std::vector<T> v = {nan, inf, -inf, std::numeric_limits<T>::max(),
+                      std::numeric_limits<T>::lowest(), 0, -0.0f};
+  // bin edges and their neighbors
+  for (int i = -1; i <= a.size() + 1; ++i) {
+    const auto x = static_cast<T>(a.value(i));
+    v.push_back(x);
+    v.push_back(std::nextafter(x, inf));
+    v.push_back(std::nextafter(x, -inf));
+  }
+  // values spread over the axis
+  const auto lo = static_cast<T>(a.value(-1)), hi = static_cast<T>(a.value(a.size() + 1));
+  for (int i = 0; i < 1000; ++i) v.push_back(lo + (hi - lo) * i / 999);
+  // odd size, so that the scalar tail of the kernels is used
+  v.push_back(lo);
+  return v;
+}
+
+template <class T>
+void test_kernel(detail::regular_index_n_kernel<T> kernel, const axis::regular<T>& a) {
+  const auto x = make_input(a);
+  std::vector<axis::index_type> ref(x.size()), out(x.size());
+  for (std::size_t i = 0; i < x.size(); ++i) ref[i] = a.index(x[i]);
+  // min and delta are not accessible, but index_n passes them to the same kernels
+  a.index_n(x.data(), out.data(), x.size());
+  BOOST_TEST_ALL_EQ(out.begin(), out.end(), ref.begin(), ref.end());
+  // kernel with parameters of axis with [0, 1) range
+  const axis::regular<T> b(a.size(), 0, 1);
+  for (std::size_t i = 0; i < x.size(); ++i) ref[i] = b.index(x[i]);
+  kernel(x.data(), out.data(), x.size(), 0, 1, static_cast<T>(b.size()));
+  BOOST_TEST_ALL_EQ(out.begin(), out.end(), ref.begin(), ref.end());
+}
+
+template <class T>
+void run_tests() {
+  std::vector<detail::regular_index_n_kernel<T>> kernels = {
+      detail::regular_index_n_scalar<T>};
+#if BOOST_HISTOGRAM_DETAIL_SIMD_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("sse2")) kernels.push_back(detail::regular_index_n_sse2);
+  if (__builtin_cpu_supports("avx2")) kernels.push_back(detail::regular_index_n_avx2);
+  if (__builtin_cpu_supports("avx512f"))
+    kernels.push_back(detail::regular_index_n_avx512);
+#endif
+
+  for (auto&& k : kernels) {
+    test_kernel<T>(k, axis::regular<T>(1, 0, 1));
+    test_kernel<T>(k, axis::regular<T>(3, -1, 1.5));
+    test_kernel<T>(k, axis::regular<T>(10, 2, -3));
+    test_kernel<T>(k, axis::regular<T>(7, 0.1f, 0.3f));
+    test_kernel<T>(k, axis::regular<T>(1000, -1e3f, 1e3f));
+  }
+
+  // axis with a transform uses the generic path
+  {
+    const auto a = axis::regular<T, axis::transform::log>(3, 1, 1e3f);
+    const auto x = std::vector<T>{0, 1, 10, 100, 1000, -1};
+    std::vector<axis::index_type> out(x.size());
+    a.index_n(x.data(), out.data(), x.size());
+    for (std::size_t i = 0; i < x.size(); ++i) BOOST_TEST_EQ(out[i], a.index(x[i]));
+  }
+}
+
+// kernels agree with the scalar version, which agrees with std::log within the bound
+void test_fast_log() {
+  std::vector<detail::fast_log_n_kernel> kernels = {detail::fast_log_n_scalar};
+#if BOOST_HISTOGRAM_DETAIL_SIMD_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("sse2")) kernels.push_back(detail::fast_log_n_sse2);
+  if (__builtin_cpu_supports("avx2")) kernels.push_back(detail::fast_log_n_avx2);
+#endif
+  const auto inf = std::numeric_limits<double>::infinity();
+  std::vector<double> x = {std::numeric_limits<double>::quiet_NaN(),
+                           inf,
+                           -inf,
+                           0,
+                           -0.0,
+                           -1,
+                           std::numeric_limits<double>::denorm_min(),
+                           std::numeric_limits<double>::min(),
+                           std::numeric_limits<double>::max(),
+                           std::sqrt(0.5),
+                           std::sqrt(2.0)};
+  for (double z = -745; z < 709; z += 0.0123) x.push_back(std::exp(z));
+  for (double z = 0.5; z < 2; z += 1e-4) x.push_back(z);
+  x.push_back(1);
+  std::vector<double> y(x.size());
+  for (auto&& k : kernels) {
+    k(x.data(), y.data(), x.size());
+    for (std::size_t i = 0; i < x.size(); ++i) {
+      const auto ref = std::log(x[i]);
+      if (std::isnan(ref)) {
+        BOOST_TEST(std::isnan(y[i]));
+        continue;
+      }
+      BOOST_TEST_EQ(y[i], detail::fast_log(x[i]));
+      if (std::isfinite(ref))
+        BOOST_TEST_LE(std::abs(y[i] - ref),
+                      axis::transform::fast_log::forward_error(y[i]));
+      else
+        BOOST_TEST_EQ(y[i], ref);
+    }
+  }
+  for (float z = -87; z < 88; z += 0.0123f) {
+    const auto xf = std::exp(z);
+    const auto ref = std::log(xf);
+    BOOST_TEST_LE(std::abs(detail::fast_log(xf) - ref),
+                  axis::transform::fast_log::forward_error(ref));
+  }
+}
+
+int main() {
+  run_tests<double>();
+  run_tests<float>();
+  test_fast_log();
+
+  return boost::report_errors();
+}
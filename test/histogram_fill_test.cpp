@@ -0,0 +1,306 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <array>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/histogram/accumulators/mean.hpp>
+#include <boost/histogram/accumulators/ostream.hpp>
+#include <boost/histogram/accumulators/thread_safe.hpp>
+#include <boost/histogram/accumulators/weighted_mean.hpp>
+#include <boost/histogram/accumulators/weighted_sum.hpp>
+#include <boost/histogram/algorithm/sum.hpp>
+#include <boost/histogram/axis.hpp>
+#include <boost/histogram/axis/ostream.hpp>
+#include <boost/histogram/histogram.hpp>
+#include <boost/histogram/ostream.hpp>
+#include <boost/histogram/storage_adaptor.hpp>
+#include <boost/variant2/variant.hpp>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "throw_exception.hpp"
+#include "utility_histogram.hpp"
+
+using namespace boost::histogram;
+using namespace boost::variant2;
+
+using def = use_default;
+
+using in = axis::integer<int, def>;
+using in_noflow = axis::integer<int, def, axis::option::none_t>;
+using reg = axis::regular<>;
+using reg_growth = axis::regular<double, def, def, axis::option::growth_t>;
+using int_growth =
+    axis::integer<double, def,
+                  decltype(axis::option::underflow | axis::option::overflow |
+                           axis::option::growth)>;
+using cat_growth = axis::category<std::string, def, axis::option::growth_t>;
+
+// more values than fit into one chunk of the batch algorithm
+constexpr unsigned ndata = 10000;
+
+std::vector<double> make_data(double lo, double hi, unsigned seed) {
+  std::vector<double> v(ndata);
+  for (auto& x : v) {
+    seed = seed * 1103515245u + 12345u;
+    x = lo + (hi - lo) * ((seed >> 8) % 10000) / 10000.0;
+  }
+  return v;
+}
+
+template <class Tag>
+void run_tests() {
+  const auto x = make_data(-3, 6, 1);
+  const auto y = make_data(-2, 4, 2);
+
+  // 1D, single column
+  {
+    auto h = make(Tag(), in{1, 3});
+    auto h2 = h;
+    h.fill(x);
+    for (auto&& xi : x) h2(xi);
+    BOOST_TEST_EQ(h, h2);
+  }
+
+  // 1D, iterable of one column
+  {
+    auto h = make(Tag(), in{1, 3});
+    auto h2 = h;
+    h.fill(std::array<std::vector<double>, 1>{{x}});
+    for (auto&& xi : x) h2(xi);
+    BOOST_TEST_EQ(h, h2);
+  }
+
+  // 1D, no flow bins
+  {
+    auto h = make(Tag(), in_noflow{1, 3});
+    auto h2 = h;
+    h.fill(x);
+    for (auto&& xi : x) h2(xi);
+    BOOST_TEST_EQ(h, h2);
+    BOOST_TEST_LT(algorithm::sum(h), ndata);
+  }
+
+  // 2D
+  {
+    auto h = make(Tag(), in{1, 3}, in_noflow{-1, 2});
+    auto h2 = h;
+    h.fill(std::array<std::vector<double>, 2>{{x, y}});
+    for (unsigned i = 0; i < ndata; ++i) h2(x[i], y[i]);
+    BOOST_TEST_EQ(h, h2);
+  }
+
+  // regular axes
+  {
+    auto h = make(Tag(), reg{10, -2, 5}, reg{3, 4, -1});
+    auto h2 = h;
+    h.fill(std::array<std::vector<double>, 2>{{x, y}});
+    for (unsigned i = 0; i < ndata; ++i) h2(x[i], y[i]);
+    BOOST_TEST_EQ(h, h2);
+  }
+
+  // 2D, columns of different value types
+  {
+    std::vector<int> yi(y.begin(), y.end());
+    using col = variant<std::vector<double>, std::vector<int>>;
+    auto h = make(Tag(), in{1, 3}, in_noflow{-1, 2});
+    auto h2 = h;
+    h.fill(std::vector<col>{x, yi});
+    for (unsigned i = 0; i < ndata; ++i) h2(x[i], yi[i]);
+    BOOST_TEST_EQ(h, h2);
+  }
+
+  // growing axes
+  {
+    auto h = make(Tag(), reg_growth{2, 0, 1});
+    auto h2 = h;
+    h.fill(x);
+    for (auto&& xi : x) h2(xi);
+    BOOST_TEST_EQ(h, h2);
+    BOOST_TEST_EQ(algorithm::sum(h), ndata);
+  }
+
+  {
+    auto h = make(Tag(), int_growth{0, 1}, in{1, 3});
+    auto h2 = h;
+    h.fill(std::array<std::vector<double>, 2>{{x, y}});
+    for (unsigned i = 0; i < ndata; ++i) h2(x[i], y[i]);
+    BOOST_TEST_EQ(h, h2);
+  }
+
+  {
+    auto h = make(Tag(), in{1, 3}, int_growth{0, 1});
+    auto h2 = h;
+    h.fill(std::array<std::vector<double>, 2>{{x, y}});
+    for (unsigned i = 0; i < ndata; ++i) h2(x[i], y[i]);
+    BOOST_TEST_EQ(h, h2);
+  }
+
+  // batch which drifts out of the axis range over several chunks
+  {
+    std::vector<double> d(ndata);
+    for (unsigned i = 0; i < ndata; ++i) d[i] = (i % 2 ? 1.0 : -1.0) * i * 0.01;
+    auto h = make(Tag(), int_growth{0, 1}, reg_growth{1, 0, 1});
+    auto h2 = h;
+    h.fill(std::array<std::vector<double>, 2>{{d, d}});
+    for (auto&& di : d) h2(di, di);
+    BOOST_TEST_EQ(h.rank(), 2);
+    BOOST_TEST_EQ(h.axis(0), h2.axis(0));
+    BOOST_TEST_EQ(h.axis(1), h2.axis(1));
+    BOOST_TEST_EQ(algorithm::sum(h), ndata);
+    // the axes grow before the values are filled, values which are exactly at a bin edge
+    // may therefore end up in a different bin than with incremental growth
+    auto h3 = h;
+    h3.reset();
+    for (auto&& di : d) h3(di, di);
+    BOOST_TEST_EQ(h, h3);
+  }
+
+  {
+    std::vector<std::string> s = {"b", "a", "b", "c", "a", "d"};
+    auto h = make(Tag(), cat_growth{});
+    auto h2 = h;
+    h.fill(s);
+    for (auto&& si : s) h2(si);
+    BOOST_TEST_EQ(h, h2);
+    BOOST_TEST_EQ(h.axis().size(), 4);
+  }
+
+  // empty batch
+  {
+    auto h = make(Tag(), in{1, 3});
+    h.fill(std::vector<double>{});
+    BOOST_TEST_EQ(algorithm::sum(h), 0);
+  }
+
+  // thread-safe storage
+  {
+    auto h = make_s(Tag(), std::vector<accumulators::thread_safe<int>>(), in{1, 3});
+    h.fill(x);
+    BOOST_TEST_EQ(algorithm::sum(h), ndata);
+  }
+
+  // weights
+  {
+    const auto w = make_data(0, 2, 3);
+    auto h = make(Tag(), in{1, 3}, in_noflow{-1, 2});
+    auto h2 = h;
+    h.fill(std::array<std::vector<double>, 2>{{x, y}}, weight(w));
+    for (unsigned i = 0; i < ndata; ++i) h2(x[i], y[i], weight(w[i]));
+    BOOST_TEST_EQ(h, h2);
+  }
+
+  {
+    const auto w = make_data(0, 2, 3);
+    auto h = make_s(Tag(), weight_storage(), int_growth{0, 1});
+    auto h2 = h;
+    h.fill(x, weight(w));
+    for (unsigned i = 0; i < ndata; ++i) h2(weight(w[i]), x[i]);
+    BOOST_TEST_EQ(h, h2);
+  }
+
+  // samples
+  {
+    const auto s = make_data(0, 10, 4);
+    auto h = make_s(Tag(), profile_storage(), in{1, 3});
+    auto h2 = h;
+    h.fill(x, sample(s));
+    for (unsigned i = 0; i < ndata; ++i) h2(x[i], sample(s[i]));
+    BOOST_TEST_EQ(h, h2);
+  }
+
+  // weights and samples
+  {
+    const auto w = make_data(0, 2, 3);
+    const auto s = make_data(0, 10, 4);
+    auto h = make_s(Tag(), weighted_profile_storage(), in{1, 3}, in_noflow{-1, 2});
+    auto h2 = h;
+    auto h3 = h;
+    const auto xy = std::array<std::vector<double>, 2>{{x, y}};
+    h.fill(xy, weight(w), sample(s));
+    h2.fill(xy, sample(s), weight(w));
+    for (unsigned i = 0; i < ndata; ++i) h3(x[i], y[i], weight(w[i]), sample(s[i]));
+    BOOST_TEST_EQ(h, h3);
+    BOOST_TEST_EQ(h2, h3);
+  }
+
+  // wrong size of weights or samples
+  {
+    auto h = make_s(Tag(), weighted_profile_storage(), in{1, 3});
+    const std::vector<double> v(3);
+    BOOST_TEST_THROWS(h.fill(x, weight(v)), std::invalid_argument);
+    BOOST_TEST_THROWS(h.fill(x, sample(v)), std::invalid_argument);
+    BOOST_TEST_THROWS(h.fill(v, weight(v), sample(x)), std::invalid_argument);
+  }
+
+  // index and fill phases separately
+  {
+    const auto w = make_data(0, 2, 3);
+    const auto xy = std::array<std::vector<double>, 2>{{x, y}};
+    auto h = make(Tag(), in{1, 3}, in_noflow{-1, 2});
+    auto h2 = make_s(Tag(), weight_storage(), in{1, 3}, in_noflow{-1, 2});
+    auto h3 = h;
+    auto h4 = h2;
+    std::vector<std::size_t> idx(ndata);
+    BOOST_TEST(h.linearize(xy, idx.begin()) == idx.end());
+    const auto a = in_noflow{-1, 2};
+    BOOST_TEST_EQ(std::count(idx.begin(), idx.end(), h.invalid_index),
+                  std::count_if(y.begin(), y.end(), [&a](double v) {
+                    const auto i = a.index(v);
+                    return i < 0 || i >= a.size();
+                  }));
+    h.fill_linearized(idx);
+    h2.fill_linearized(idx, weight(w));
+    h3.fill(xy);
+    h4.fill(xy, weight(w));
+    BOOST_TEST_EQ(h, h3);
+    BOOST_TEST_EQ(h2, h4);
+
+    auto p = make_s(Tag(), weighted_profile_storage(), in{1, 3}, in_noflow{-1, 2});
+    auto p2 = p;
+    p.fill_linearized(idx, sample(x), weight(w));
+    p2.fill(xy, weight(w), sample(x));
+    BOOST_TEST_EQ(p, p2);
+
+    // growing axes are not grown
+    auto g = make(Tag(), reg_growth{2, 0, 1});
+    std::vector<std::size_t> gidx;
+    g.linearize(std::vector<double>{-1, 0.2, 0.7, 2}, std::back_inserter(gidx));
+    BOOST_TEST_EQ(g.axis().size(), 2);
+    BOOST_TEST_EQ(gidx.size(), 4);
+    BOOST_TEST_EQ(gidx[0], g.invalid_index);
+    BOOST_TEST_EQ(gidx[1], 0);
+    BOOST_TEST_EQ(gidx[2], 1);
+    BOOST_TEST_EQ(gidx[3], g.invalid_index);
+
+    BOOST_TEST_THROWS(h.fill_linearized(std::vector<std::size_t>{0, 100}),
+                      std::out_of_range);
+    BOOST_TEST_THROWS(h2.fill_linearized(std::vector<std::size_t>(3), weight(w)),
+                      std::invalid_argument);
+    BOOST_TEST_EQ(h, h3);
+  }
+
+  // wrong number of columns or column size
+  {
+    auto h = make(Tag(), in{1, 3}, in{1, 3});
+    BOOST_TEST_THROWS(h.fill(x), std::invalid_argument);
+    BOOST_TEST_THROWS(h.fill(std::array<std::vector<double>, 1>{{x}}),
+                      std::invalid_argument);
+    BOOST_TEST_THROWS(
+        h.fill(std::array<std::vector<double>, 2>{{x, std::vector<double>(3)}}),
+        std::invalid_argument);
+    BOOST_TEST_EQ(algorithm::sum(h), 0);
+  }
+}
+
+int main() {
+  run_tests<static_tag>();
+  run_tests<dynamic_tag>();
+
+  return boost::report_errors();
+}
@@ -4,12 +4,15 @@
 // (See accompanying file LICENSE_1_0.txt
 // or copy at http://www.boost.org/LICENSE_1_0.txt)
 
+#include <algorithm>
 #include <boost/core/lightweight_test.hpp>
 #include <boost/histogram/algorithm/sum.hpp>
 #include <boost/histogram/axis.hpp>
 #include <boost/histogram/axis/ostream.hpp>
 #include <boost/histogram/histogram.hpp>
 #include <boost/histogram/ostream.hpp>
+#include <boost/histogram/unlimited_storage.hpp>
+#include <boost/histogram/unsafe_access.hpp>
 #include <string>
 #include <utility>
 #include "throw_exception.hpp"
@@ -176,6 +179,58 @@ void run_tests() {
     BOOST_TEST_THROWS(h(0), std::invalid_argument);
   }
 
+  // growth along the last axis resizes a vector storage in place
+  {
+    auto h = make_s(Tag(), std::vector<int>(), axis::integer<>(0, 2), integer(0, 1));
+    auto h2 = make_s(Tag(), unlimited_storage<>(), axis::integer<>(0, 2), integer(0, 1));
+    const double values[] = {0.5, 3, 4, -2, 10, -1, 0, 20, -5, -20, 100};
+    int i = 0;
+    for (auto&& v : values) {
+      h(i % 4 - 1, v);
+      h2(i % 4 - 1, v);
+      ++i;
+    }
+    BOOST_TEST_EQ(h.axis(1).size(), 121);
+    BOOST_TEST_EQ(h.size(), h2.size());
+    BOOST_TEST(std::equal(h.begin(), h.end(), h2.begin()));
+    BOOST_TEST_EQ(algorithm::sum(h), 11);
+    // capacity is reserved in advance
+    BOOST_TEST_GT(unsafe_access::storage(h).capacity(), h.size());
+    h(0, 200);
+    h2(0, 200);
+    BOOST_TEST(std::equal(h.begin(), h.end(), h2.begin()));
+  }
+
+  // growth of several axes in both directions relocates all cells
+  {
+    using in = axis::integer<>;
+    auto h = make_s(Tag(), std::vector<int>(), integer(0, 2), in(0, 2), integer(0, 1));
+    auto h2 = make_s(Tag(), unlimited_storage<>(), integer(0, 2), in(0, 2), integer(0, 1));
+    // cell type of unlimited_storage is larger than 8 bit
+    for (int i = 0; i < 300; ++i) {
+      h(0, 0, 0);
+      h2(0, 0, 0);
+    }
+    const double values[][3] = {{1, -1, 0},  {-3, 1, 2},  {4, 5, -2}, {0, 2, 7},
+                                {-6, 0, -4}, {2, -8, 1},  {9, 1, 3},  {1, 0, -9},
+                                {-3, 1, 2},  {12, 3, 12}, {-1, -1, 0}};
+    for (auto&& v : values) {
+      h(v[0], v[1], v[2]);
+      h2(v[0], v[1], v[2]);
+    }
+    BOOST_TEST_EQ(h.axis(0).size(), 19);
+    BOOST_TEST_EQ(h.axis(2).size(), 22);
+    BOOST_TEST_EQ(h.size(), h2.size());
+    BOOST_TEST(std::equal(h.begin(), h.end(), h2.begin()));
+    BOOST_TEST_EQ(algorithm::sum(h), 311);
+    BOOST_TEST_EQ(h.at(h.axis(0).index(0), 0, h.axis(2).index(0)), 300);
+    BOOST_TEST_EQ(h.at(h.axis(0).index(-3), 1, h.axis(2).index(2)), 2);
+    for (auto&& v : values) {
+      const auto j = h.axis(1).index(v[1]);
+      BOOST_TEST_GE(h.at(h.axis(0).index(v[0]), j, h.axis(2).index(v[2])), 1);
+    }
+  }
+
   // mix of a growing and a non-growing axis
   {
     using reg_nogrow = axis::regular<>;
@@ -0,0 +1,75 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#define BOOST_HISTOGRAM_GROWTH_LIMIT 100
+
+#include <boost/core/lightweight_test.hpp>
+#include <boost/histogram/algorithm/sum.hpp>
+#include <boost/histogram/axis.hpp>
+#include <boost/histogram/axis/ostream.hpp>
+#include <boost/histogram/histogram.hpp>
+#include <boost/histogram/ostream.hpp>
+#include <boost/histogram/unlimited_storage.hpp>
+#include <stdexcept>
+#include <vector>
+#include "throw_exception.hpp"
+#include "utility_histogram.hpp"
+
+using namespace boost::histogram;
+
+using integer = axis::integer<int, use_default, axis::option::growth_t>;
+using category = axis::category<int, use_default, axis::option::growth_t>;
+
+template <class Tag>
+void run_tests() {
+  // single values
+  {
+    auto h = make(Tag(), integer(0, 2));
+    h(0);
+    h(-10);
+    h(89);
+    BOOST_TEST_EQ(h.axis().size(), 100);
+    BOOST_TEST_THROWS(h(90), std::length_error);
+    BOOST_TEST_THROWS(h(-11), std::length_error);
+    BOOST_TEST_THROWS(h(1000000), std::length_error);
+    BOOST_TEST_EQ(h.axis().size(), 100);
+    BOOST_TEST_EQ(h.axis().value(0), -10);
+    BOOST_TEST_EQ(h.size(), 100);
+    BOOST_TEST_EQ(algorithm::sum(h), 3);
+    h(5);
+    BOOST_TEST_EQ(h.at(15), 1);
+  }
+
+  // limit applies to the number of cells, not to each axis
+  {
+    auto h = make_s(Tag(), unlimited_storage<>(), integer(0, 10), category{0, 1});
+    for (int i = 2; i < 10; ++i) h(0, i);
+    BOOST_TEST_EQ(h.size(), 100);
+    BOOST_TEST_THROWS(h(0, 10), std::length_error);
+    BOOST_TEST_THROWS(h(10, 0), std::length_error);
+    BOOST_TEST_EQ(h.axis(0).size(), 10);
+    BOOST_TEST_EQ(h.axis(1).size(), 10);
+    BOOST_TEST_EQ(algorithm::sum(h), 8);
+  }
+
+  // nothing of a batch is filled if it would grow too large
+  {
+    auto h = make(Tag(), integer(0, 2));
+    BOOST_TEST_THROWS(h.fill(std::vector<int>{0, 1, 200}), std::length_error);
+    BOOST_TEST_EQ(h.axis().size(), 2);
+    BOOST_TEST_EQ(algorithm::sum(h), 0);
+    h.fill(std::vector<int>{0, 1, 50});
+    BOOST_TEST_EQ(h.axis().size(), 51);
+    BOOST_TEST_EQ(algorithm::sum(h), 3);
+  }
+}
+
+int main() {
+  run_tests<static_tag>();
+  run_tests<dynamic_tag>();
+
+  return boost::report_errors();
+}
@@ -4,16 +4,29 @@
 // (See accompanying file LICENSE_1_0.txt
 // or copy at http://www.boost.org/LICENSE_1_0.txt)
 
+#include <algorithm>
 #include <boost/core/lightweight_test.hpp>
+#include <boost/histogram/accumulators/ostream.hpp>
 #include <boost/histogram/accumulators/thread_safe.hpp>
+#include <boost/histogram/accumulators/weighted_mean.hpp>
 #include <boost/histogram/algorithm/sum.hpp>
+#include <boost/histogram/axis/category.hpp>
 #include <boost/histogram/axis/integer.hpp>
 #include <boost/histogram/axis/ostream.hpp>
+#include <boost/histogram/indexed.hpp>
 #include <boost/histogram/ostream.hpp>
+#include <boost/histogram/sharded_storage.hpp>
 #include <boost/histogram/storage_adaptor.hpp>
+#include <boost/histogram/thread_pool.hpp>
+#include <boost/histogram/unlimited_storage.hpp>
+#include <atomic>
 #include <iostream>
 #include <random>
+#include <stdexcept>
+#include <string>
 #include <thread>
+#include <vector>
+#include "is_close.hpp"
 #include "throw_exception.hpp"
 #include "utility_histogram.hpp"
 
@@ -21,6 +34,15 @@ using namespace boost::histogram;
 
 constexpr auto n_fill = 400000;
 
+// value type without std::hash
+struct label {
+  int value;
+  bool operator==(const label& o) const noexcept { return value == o.value; }
+  friend std::ostream& operator<<(std::ostream& os, const label& l) {
+    return os << l.value;
+  }
+};
+
 template <class Tag, class A1, class A2, class X, class Y>
 void fill_test(const A1& a1, const A2& a2, const X& x, const Y& y) {
   auto h1 = make_s(Tag{}, dense_storage<int>(), a1, a2);
@@ -47,6 +69,61 @@ void fill_test(const A1& a1, const A2& a2, const X& x, const Y& y) {
   BOOST_TEST_EQ(h1, h2);
 }
 
+// growing category axis filled with labels from several threads
+template <class Tag, class Storage>
+void growing_category_test() {
+  std::vector<std::string> labels;
+  for (int k = 0; k < 100; ++k) labels.push_back("label" + std::to_string(k));
+  using cat = axis::category<std::string, use_default, axis::option::growth_t>;
+  auto h = make_s(Tag{}, Storage(), cat{}, axis::integer<>(0, 2));
+  auto run = [&h, &labels](int k) {
+    for (unsigned i = 0; i < n_fill / 4; ++i) {
+      h(labels[(i * (k + 1)) % labels.size()], i % 2);
+      h(weight(2), labels[i % 10], 1);
+    }
+  };
+  std::vector<std::thread> threads;
+  for (int k = 0; k < 4; ++k) threads.emplace_back(run, k);
+  for (auto&& t : threads) t.join();
+
+  BOOST_TEST_EQ(h.axis(0).size(), labels.size());
+  BOOST_TEST_EQ(algorithm::sum(h), 3 * n_fill);
+  for (unsigned j = 0; j < 10; ++j) {
+    const auto i = h.axis(0).index(labels[j]);
+    BOOST_TEST_GE(h.at(i, 1), 2 * n_fill / 10);
+  }
+}
+
+// executor which runs all tasks in the calling thread, but reports them as running in
+// the threads given by thread_of, to check that partials of idle threads are skipped
+struct serial_executor {
+  std::size_t size() const noexcept { return 4; }
+
+  template <class F>
+  void run(std::size_t n, F&& f) {
+    for (std::size_t i = 0; i < n; ++i) f(i, thread_of(i));
+  }
+
+  std::size_t (*thread_of)(std::size_t);
+};
+
+template <class Tag, class Storage, class Executor, class A1, class A2, class X,
+          class Y>
+void parallel_fill_test(Executor& pool, const A1& a1, const A2& a2, const X& x,
+                        const Y& y) {
+  auto h1 = make_s(Tag{}, Storage(), a1, a2);
+  auto h2 = h1;
+  const auto xy = std::vector<X>{x, y};
+  h1.fill(xy);
+  h2.fill(pool, xy);
+  BOOST_TEST_EQ(algorithm::sum(h2), n_fill);
+  BOOST_TEST_EQ(h1, h2);
+  // storage with values which were filled before
+  h1.fill(xy);
+  h2.fill(pool, xy);
+  BOOST_TEST_EQ(h1, h2);
+}
+
 template <class T>
 void tests() {
   std::mt19937 gen(1);
@@ -61,9 +138,100 @@ void tests() {
   fill_test<T>(ig{0, 1}, i{0, 1}, vi, vj);
   fill_test<T>(i{0, 1}, ig{0, 1}, vi, vj);
   fill_test<T>(ig{0, 1}, ig{0, 1}, vi, vj);
+  // growing axis with overflow bin
+  using igo = axis::integer<int, use_default,
+                            decltype(axis::option::growth | axis::option::overflow)>;
+  fill_test<T>(igo{0, 1}, i{0, 1}, vi, vj);
+  // category axis without hash index, which adapts its search order to skewed values
+  {
+    std::vector<label> labels;
+    for (int k = 0; k < 200; ++k) labels.push_back({k});
+    std::geometric_distribution<> gd(0.2);
+    std::vector<label> vs(n_fill);
+    std::generate(vs.begin(), vs.end(),
+                  [&] { return labels[199 - std::min(gd(gen), 199)]; });
+    fill_test<T>(axis::category<label>(labels), i{0, 1}, vs, vj);
+  }
+
+  growing_category_test<T, dense_storage<accumulators::thread_safe<int>>>();
+  growing_category_test<T, sharded_storage<dense_storage<int>>>();
+
+  for (auto thread_of : {+[](std::size_t) -> std::size_t { return 0; },
+                         +[](std::size_t) -> std::size_t { return 2; },
+                         +[](std::size_t) -> std::size_t { return 3; },
+                         +[](std::size_t i) -> std::size_t { return i % 2 ? 3 : 1; }}) {
+    serial_executor ex{thread_of};
+    parallel_fill_test<T, dense_storage<int>>(ex, i{-5, 6}, i{0, 1}, vi, vj);
+    parallel_fill_test<T, unlimited_storage<>>(ex, i{0, 1}, i{-5, 6}, vi, vj);
+  }
+
+  for (unsigned nthreads : {1, 3, 4}) {
+    thread_pool pool(nthreads);
+    BOOST_TEST_EQ(pool.size(), nthreads);
+    parallel_fill_test<T, dense_storage<int>>(pool, i{-5, 6}, i{0, 1}, vi, vj);
+    parallel_fill_test<T, unlimited_storage<>>(pool, i{0, 1}, i{-5, 6}, vi, vj);
+    parallel_fill_test<T, sharded_storage<dense_storage<int>>>(pool, i{0, 1}, i{0, 1},
+                                                               vi, vj);
+    parallel_fill_test<T, dense_storage<int>>(pool, ig{0, 1}, i{0, 1}, vi, vj);
+
+    // weights and samples
+    std::vector<double> w(vi.size());
+    std::transform(vi.begin(), vi.end(), w.begin(), [](int v) { return v + 6.0; });
+    auto h1 = make_s(T{}, weighted_profile_storage(), i{-5, 6});
+    auto h2 = h1;
+    h1.fill(vj, weight(w), sample(vi));
+    h2.fill(pool, vj, sample(vi), weight(w));
+    for (auto&& x : indexed(h1)) {
+      BOOST_TEST_EQ(x->sum_of_weights(), h2[x.index()].sum_of_weights());
+      BOOST_TEST_IS_CLOSE(x->value(), h2[x.index()].value(), 1e-9);
+    }
+    BOOST_TEST_THROWS(h2.fill(pool, vj, weight(std::vector<double>(3))),
+                      std::invalid_argument);
+  }
+}
+
+void thread_pool_tests() {
+  thread_pool pool(4);
+  for (std::size_t n : {0, 1, 3, 100}) {
+    std::vector<std::atomic<int>> calls(n);
+    for (auto&& c : calls) c = 0;
+    pool.run(n, [&calls](std::size_t i, std::size_t) { ++calls[i]; });
+    for (auto&& c : calls) BOOST_TEST_EQ(c, 1);
+  }
+
+  // thread indices are in [0, size()) and calls with the same index never overlap
+  {
+    std::vector<std::atomic<int>> active(pool.size());
+    for (auto&& a : active) a = 0;
+    std::atomic<int> overlaps{0};
+    pool.run(1000, [&](std::size_t, std::size_t t) {
+      if (!(t < active.size())) {
+        ++overlaps;
+        return;
+      }
+      if (active[t]++ > 0) ++overlaps;
+      std::this_thread::yield();
+      --active[t];
+    });
+    BOOST_TEST_EQ(overlaps, 0);
+  }
+
+  // exceptions are passed to the calling thread after all tasks are done
+  std::atomic<int> ncalls{0};
+  BOOST_TEST_THROWS(pool.run(10,
+                             [&ncalls](std::size_t i, std::size_t) {
+                               ++ncalls;
+                               if (i == 5) throw std::runtime_error("");
+                             }),
+                    std::runtime_error);
+  BOOST_TEST_EQ(ncalls, 10);
+
+  // default uses all hardware threads
+  BOOST_TEST_GE(thread_pool().size(), 1);
 }
 
 int main() {
+  thread_pool_tests();
   tests<static_tag>();
   tests<dynamic_tag>();
 
@@ -0,0 +1,43 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/assert.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/histogram/paged_unlimited_storage.hpp>
+#include <boost/histogram/serialization.hpp>
+#include <boost/histogram/unsafe_access.hpp>
+#include <memory>
+#include "throw_exception.hpp"
+#include "utility_serialization.hpp"
+
+using namespace boost::histogram;
+
+using storage_type = paged_unlimited_storage<std::allocator<char>, 2>;
+
+int main(int argc, char** argv) {
+  BOOST_ASSERT(argc == 2);
+
+  // pages of different types are restored
+  storage_type a;
+  a.reset(5);
+  ++a[0];
+  a[2] = 1000;
+  a[4] += storage_type::large_int(3);
+  a[4] += 0.5;
+  const auto filename = join(argv[1], "paged_unlimited_storage_serialization_test.xml");
+  print_xml(filename, a);
+  storage_type b;
+  BOOST_TEST(!(a == b));
+  load_xml(filename, b);
+  BOOST_TEST(a == b);
+  const auto& pages = unsafe_access::paged_unlimited_storage_pages(b);
+  BOOST_TEST_EQ(pages.size(), 3);
+  BOOST_TEST_EQ(pages[0].type, 0);
+  BOOST_TEST_EQ(pages[1].type, 1);
+  BOOST_TEST_EQ(pages[2].type, 5);
+
+  return boost::report_errors();
+}
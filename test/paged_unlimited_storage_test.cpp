@@ -0,0 +1,245 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/core/lightweight_test_trait.hpp>
+#include <boost/histogram/algorithm/project.hpp>
+#include <boost/histogram/algorithm/sum.hpp>
+#include <boost/histogram/axis/integer.hpp>
+#include <boost/histogram/literals.hpp>
+#include <boost/histogram/make_histogram.hpp>
+#include <boost/histogram/paged_unlimited_storage.hpp>
+#include <boost/histogram/storage_adaptor.hpp>
+#include <boost/histogram/unlimited_storage.hpp>
+#include <boost/histogram/unsafe_access.hpp>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+#include "std_ostream.hpp"
+#include "throw_exception.hpp"
+
+using namespace boost::histogram;
+using namespace boost::histogram::literals; // to get _c suffix
+
+// small pages to test many pages with few cells
+using storage_type = paged_unlimited_storage<std::allocator<char>, 4>;
+using large_int = storage_type::large_int;
+
+// type index of each page, see unlimited_storage::buffer_type::types
+std::vector<unsigned> page_types(storage_type& s) {
+  std::vector<unsigned> r;
+  for (auto&& page : unsafe_access::paged_unlimited_storage_pages(s))
+    r.push_back(page.type);
+  return r;
+}
+
+int main() {
+  using types = std::vector<unsigned>;
+
+  // empty state
+  {
+    storage_type a;
+    BOOST_TEST_EQ(a.size(), 0);
+    BOOST_TEST(a.begin() == a.end());
+    BOOST_TEST(a == storage_type{});
+  }
+
+  // reset
+  {
+    storage_type a;
+    a.reset(10);
+    BOOST_TEST_EQ(a.size(), 10);
+    BOOST_TEST_EQ(std::distance(a.begin(), a.end()), 10);
+    BOOST_TEST_EQ(page_types(a), (types{0, 0, 0}));
+    for (auto&& x : a) BOOST_TEST_EQ(x, 0);
+    a.reset(4);
+    BOOST_TEST_EQ(a.size(), 4);
+    BOOST_TEST_EQ(page_types(a), (types{0}));
+    a.reset(0);
+    BOOST_TEST_EQ(a.size(), 0);
+  }
+
+  // only the page of the overflowing cell is widened
+  {
+    storage_type a;
+    a.reset(10);
+    for (int i = 0; i < 255; ++i) ++a[5];
+    BOOST_TEST_EQ(page_types(a), (types{0, 0, 0}));
+    ++a[5];
+    BOOST_TEST_EQ(a[5], 256);
+    BOOST_TEST_EQ(page_types(a), (types{0, 1, 0}));
+    a[9] += std::numeric_limits<std::uint32_t>::max();
+    BOOST_TEST_EQ(page_types(a), (types{0, 1, 2}));
+    a[9] += std::numeric_limits<std::uint64_t>::max();
+    BOOST_TEST_EQ(page_types(a), (types{0, 1, 4}));
+    BOOST_TEST_EQ(a[9], 1.0 * std::numeric_limits<std::uint64_t>::max() +
+                            std::numeric_limits<std::uint32_t>::max());
+    a[0] += 0.5;
+    BOOST_TEST_EQ(page_types(a), (types{5, 1, 4}));
+    BOOST_TEST_EQ(a[0], 0.5);
+    BOOST_TEST_EQ(a[5], 256);
+    for (std::size_t i : {1, 2, 3, 4, 6, 7, 8}) BOOST_TEST_EQ(a[i], 0);
+  }
+
+  // same results as unlimited_storage
+  {
+    storage_type a;
+    unlimited_storage<> b;
+    a.reset(13);
+    b.reset(13);
+    for (unsigned i = 0; i < 1000; ++i) {
+      const auto k = (i * i) % 13;
+      ++a[k];
+      ++b[k];
+      a[k] += i;
+      b[k] += i;
+    }
+    BOOST_TEST(a == b);
+    BOOST_TEST(a == std::vector<double>(b.begin(), b.end()));
+    BOOST_TEST(std::equal(a.begin(), a.end(), b.begin(), b.end()));
+    a *= 0.5;
+    b *= 0.5;
+    BOOST_TEST(a == b);
+  }
+
+  // copy and equal
+  {
+    const std::uint16_t v[6] = {1, 2, 3, 4, 5, 600};
+    const auto a = storage_type(6, v);
+    auto b(a);
+    BOOST_TEST(a == b);
+    ++b[0];
+    BOOST_TEST(!(a == b));
+    b = a;
+    BOOST_TEST(a == b);
+
+    // equal for pages of different types
+    storage_type c;
+    c.reset(6);
+    for (std::size_t i = 0; i < 6; ++i) c[i] = v[i];
+    BOOST_TEST_EQ(page_types(c), (types{0, 1}));
+    BOOST_TEST(a == c);
+    c[1] = 2.5;
+    BOOST_TEST(!(a == c));
+    c.reset(7);
+    BOOST_TEST(!(a == c));
+  }
+
+  // multiply
+  {
+    storage_type a;
+    a.reset(6);
+    ++a[0];
+    a[5] += large_int(2);
+    a *= 3;
+    BOOST_TEST_EQ(page_types(a), (types{5, 5}));
+    BOOST_TEST_EQ(a[0], 3);
+    BOOST_TEST_EQ(a[1], 0);
+    BOOST_TEST_EQ(a[5], 6);
+    a *= 0.5;
+    BOOST_TEST_EQ(a[0], 1.5);
+  }
+
+  // convert_foreign_storage
+  {
+    storage_adaptor<std::vector<std::uint32_t>> s;
+    s.reset(9);
+    s[1] = 3;
+    s[8] = 100000;
+    storage_type a(s);
+    BOOST_TEST_EQ(a.size(), 9);
+    BOOST_TEST_EQ(page_types(a), (types{2, 2, 2}));
+    BOOST_TEST(a == s);
+
+    const std::vector<double> d = {1.5, 2, 3, 4, 5};
+    a = d;
+    BOOST_TEST_EQ(page_types(a), (types{5, 5}));
+    BOOST_TEST(a == d);
+  }
+
+  // reference
+  {
+    storage_type a;
+    a.reset(8);
+    a[0] = 1;
+    a[7] = a[0];
+    BOOST_TEST_EQ(a[7], 1);
+    a[7] += a[0];
+    BOOST_TEST_EQ(a[7], 2);
+    a[4] -= 10;
+    BOOST_TEST_EQ(a[4], -10);
+    BOOST_TEST_EQ(page_types(a), (types{0, 5}));
+    BOOST_TEST_LT(a[4], a[0]);
+    BOOST_TEST_GT(a[7], a[0]);
+    const auto& ca = a;
+    BOOST_TEST_EQ(ca[7], 2);
+  }
+
+  // iterators
+  {
+    using iterator = typename storage_type::iterator;
+    using value_type = typename std::iterator_traits<iterator>::value_type;
+    using reference = typename std::iterator_traits<iterator>::reference;
+
+    BOOST_TEST_TRAIT_SAME(value_type, double);
+    BOOST_TEST_TRAIT_FALSE((std::is_same<reference, double&>));
+
+    storage_type a;
+    a.reset(10);
+    *(a.begin() + 5) = 300;
+    BOOST_TEST_EQ(page_types(a), (types{0, 1, 0}));
+
+    std::vector<double> b(10, 1);
+    std::copy(b.begin(), b.end(), a.begin());
+    const auto& aconst = a;
+    BOOST_TEST(std::equal(aconst.begin(), aconst.end(), b.begin(), b.end()));
+
+    std::partial_sum(a.begin(), a.end(), a.begin());
+    for (std::size_t i = 0; i < 10; ++i) BOOST_TEST_EQ(a[i], i + 1);
+
+    storage_type::iterator it1 = a.begin() + 5;
+    BOOST_TEST_EQ(*it1, 6);
+    *it1 = 300;
+    storage_type::const_iterator it2 = it1;
+    BOOST_TEST_EQ(*it2, 300);
+    BOOST_TEST_EQ(aconst.end() - it2, 5);
+  }
+
+  // histogram
+  {
+    auto h = make_histogram_with(paged_unlimited_storage<>(),
+                                 axis::integer<>(0, 100), axis::integer<>(0, 100));
+    const auto& pages =
+        unsafe_access::paged_unlimited_storage_pages(unsafe_access::storage(h));
+    BOOST_TEST_EQ(pages.size(), 3);
+    for (int i = 0; i < 1000; ++i) h(i % 100, 7);
+    for (int i = 0; i < 70000; ++i) h(5, 99);
+    BOOST_TEST_EQ(h.at(3, 7), 10);
+    BOOST_TEST_EQ(h.at(5, 99), 70000);
+    BOOST_TEST_EQ(algorithm::sum(h), 71000);
+
+    // only the page with cell (5, 99) is widened
+    BOOST_TEST_EQ(pages[0].type, 0);
+    BOOST_TEST_EQ(pages[1].type, 0);
+    BOOST_TEST_EQ(pages[2].type, 2);
+
+    auto p = algorithm::project(h, 0_c);
+    BOOST_TEST_EQ(p.at(3), 10);
+    BOOST_TEST_EQ(p.at(5), 70010);
+
+    auto h2 = h;
+    h2 += h;
+    BOOST_TEST_EQ(h2.at(5, 99), 140000);
+    h2 *= 0.5;
+    BOOST_TEST(h2 == h);
+  }
+
+  return boost::report_errors();
+}
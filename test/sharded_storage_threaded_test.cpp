@@ -0,0 +1,82 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/histogram/accumulators/mean.hpp>
+#include <boost/histogram/accumulators/ostream.hpp>
+#include <boost/histogram/axis/integer.hpp>
+#include <boost/histogram/axis/ostream.hpp>
+#include <boost/histogram/indexed.hpp>
+#include <boost/histogram/make_histogram.hpp>
+#include <boost/histogram/ostream.hpp>
+#include <boost/histogram/sharded_storage.hpp>
+#include <boost/histogram/storage_adaptor.hpp>
+#include <boost/histogram/unlimited_storage.hpp>
+#include <random>
+#include <vector>
+#include "is_close.hpp"
+#include "throw_exception.hpp"
+#include "utility_histogram.hpp"
+#include "utility_threaded.hpp"
+
+using namespace boost::histogram;
+
+constexpr auto n_fill = 400000;
+
+template <class Tag, class Storage, class A1, class A2, class X, class Y>
+void fill_test(const A1& a1, const A2& a2, const X& x, const Y& y) {
+  threaded_fill_test<Tag, sharded_storage<Storage>>(a1, a2, x, y,
+                                                    [](auto& s) { s.flush(); });
+}
+
+template <class Tag>
+void tests() {
+  std::mt19937 gen(1);
+  std::uniform_int_distribution<> id(-5, 5);
+  std::vector<int> vi(n_fill), vj(n_fill);
+  std::generate(vi.begin(), vi.end(), [&] { return id(gen); });
+  std::generate(vj.begin(), vj.end(), [&] { return id(gen); });
+
+  using i = axis::integer<>;
+  using ig = axis::integer<int, use_default, axis::option::growth_t>;
+  fill_test<Tag, dense_storage<int>>(i{0, 1}, i{0, 1}, vi, vj);
+  fill_test<Tag, dense_storage<int>>(ig{0, 1}, i{0, 1}, vi, vj);
+  fill_test<Tag, unlimited_storage<>>(i{0, 1}, i{0, 1}, vi, vj);
+  fill_test<Tag, unlimited_storage<>>(i{0, 1}, ig{0, 1}, vi, vj);
+
+  // profile
+  {
+    auto h = make_s(Tag{}, sharded_storage<profile_storage>(), i{-5, 6});
+    auto h2 = make_s(Tag{}, profile_storage(), i{-5, 6});
+    for (unsigned k = 0; k < n_fill; ++k) h2(vi[k], sample(vj[k]));
+    constexpr unsigned shift = n_fill / 4;
+    run_in_threads([&](unsigned k) {
+      for (auto l = k * shift; l < (k + 1) * shift; ++l) h(vi[l], sample(vj[l]));
+    });
+    for (auto&& x : indexed(h)) {
+      BOOST_TEST_EQ(x->count(), h2.at(x.index()).count());
+      BOOST_TEST_IS_CLOSE(x->value(), h2.at(x.index()).value(), 1e-12);
+    }
+  }
+}
+
+int main() {
+  // works with make_histogram_with
+  {
+    auto h = make_histogram_with(sharded_storage<dense_storage<int>>(),
+                                 axis::integer<>(0, 3));
+    h(0);
+    h(1);
+    h(1);
+    BOOST_TEST_EQ(h.at(1), 2);
+  }
+
+  tests<static_tag>();
+  tests<dynamic_tag>();
+
+  return boost::report_errors();
+}
@@ -0,0 +1,42 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/assert.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/histogram/serialization.hpp>
+#include <boost/histogram/striped_storage.hpp>
+#include <thread>
+#include "throw_exception.hpp"
+#include "utility_serialization.hpp"
+
+using namespace boost::histogram;
+
+using storage_type = striped_storage<unsigned, 3>;
+
+int main(int argc, char** argv) {
+  BOOST_ASSERT(argc == 2);
+
+  // increments in different stripes are summed
+  storage_type a;
+  a.reset(3);
+  ++a[0];
+  a[1] += 2;
+  std::thread t([&a] { a[1] += 3; });
+  t.join();
+  const auto filename = join(argv[1], "striped_storage_serialization_test.xml");
+  print_xml(filename, a);
+  storage_type b;
+  BOOST_TEST(!(a == b));
+  load_xml(filename, b);
+  BOOST_TEST(a == b);
+  BOOST_TEST_EQ(b[1], 5);
+
+  // loaded storage can be filled again
+  ++b[1];
+  BOOST_TEST_EQ(b[1], 6);
+
+  return boost::report_errors();
+}
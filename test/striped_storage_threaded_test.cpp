@@ -0,0 +1,115 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <array>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/histogram/axis/integer.hpp>
+#include <boost/histogram/axis/ostream.hpp>
+#include <boost/histogram/indexed.hpp>
+#include <boost/histogram/make_histogram.hpp>
+#include <boost/histogram/ostream.hpp>
+#include <boost/histogram/storage_adaptor.hpp>
+#include <boost/histogram/striped_storage.hpp>
+#include <boost/histogram/thread_pool.hpp>
+#include <random>
+#include <vector>
+#include "throw_exception.hpp"
+#include "utility_histogram.hpp"
+#include "utility_threaded.hpp"
+
+using namespace boost::histogram;
+
+constexpr auto n_fill = 400000;
+
+template <class Tag, class Storage, class A1, class A2, class X, class Y>
+void fill_test(const A1& a1, const A2& a2, const X& x, const Y& y) {
+  // striped_storage has no buffers, all increments are visible immediately
+  threaded_fill_test<Tag, Storage>(a1, a2, x, y, [](auto&) {});
+}
+
+template <class Tag>
+void tests() {
+  std::mt19937 gen(1);
+  std::uniform_int_distribution<> id(-5, 5);
+  std::vector<int> vi(n_fill), vj(n_fill);
+  std::generate(vi.begin(), vi.end(), [&] { return id(gen); });
+  std::generate(vj.begin(), vj.end(), [&] { return id(gen); });
+
+  using i = axis::integer<>;
+  using ig = axis::integer<int, use_default, axis::option::growth_t>;
+  fill_test<Tag, striped_storage<>>(i{-5, 6}, i{-5, 6}, vi, vj);
+  fill_test<Tag, striped_storage<unsigned, 1>>(i{0, 1}, i{0, 1}, vi, vj);
+  fill_test<Tag, striped_storage<unsigned, 3>>(ig{0, 1}, i{0, 1}, vi, vj);
+  fill_test<Tag, striped_storage<unsigned long, 4>>(i{0, 1}, ig{0, 1}, vi, vj);
+
+  // parallel batch fill
+  {
+    auto h1 = make_s(Tag{}, dense_storage<int>(), i{-5, 6}, i{-5, 6});
+    auto h2 = make_s(Tag{}, striped_storage<unsigned, 4>(), i{-5, 6}, i{-5, 6});
+    thread_pool pool(4);
+    h1.fill(std::array<std::vector<int>, 2>{{vi, vj}});
+    h2.fill(pool, std::array<std::vector<int>, 2>{{vi, vj}});
+    BOOST_TEST_EQ(h2, h1);
+  }
+}
+
+int main() {
+  // storage interface
+  {
+    striped_storage<unsigned, 3> s;
+    BOOST_TEST_EQ(s.stripes(), 3);
+    s.reset(5);
+    BOOST_TEST_EQ(s.size(), 5);
+    ++s[1];
+    s[1] += 2;
+    s[2] = 4;
+    BOOST_TEST_EQ(s[1], 3);
+    BOOST_TEST_EQ(s[2], 4);
+    s[3] = s[2];
+    BOOST_TEST_EQ(s[3], 4);
+    BOOST_TEST(s[1] < s[2]);
+    BOOST_TEST(s == (std::vector<unsigned>{0, 3, 4, 4, 0}));
+
+    const auto s2 = s;
+    BOOST_TEST(s2 == s);
+    BOOST_TEST_EQ(std::count(s2.begin(), s2.end(), 4u), 2);
+
+    striped_storage<unsigned, 3> s3(std::vector<int>{1, 2, 3});
+    BOOST_TEST_EQ(s3[2], 3);
+    s3.reset(3);
+    BOOST_TEST_EQ(s3[2], 0);
+
+    BOOST_TEST_GE(striped_storage<>().stripes(), 1);
+  }
+
+  // increments from different threads go to different stripes
+  {
+    striped_storage<unsigned, 4> s;
+    s.reset(1);
+    run_in_threads([&s](int) {
+      for (unsigned i = 0; i < 1000; ++i) ++s[0];
+    });
+    BOOST_TEST_EQ(s[0], 4000);
+  }
+
+  // works with make_histogram_with
+  {
+    auto h = make_histogram_with(striped_storage<>(), axis::integer<>(0, 3));
+    h(0);
+    h(1);
+    h(1);
+    BOOST_TEST_EQ(h.at(1), 2);
+    auto h2 = h;
+    h2 += h;
+    BOOST_TEST_EQ(h2.at(1), 4);
+  }
+
+  tests<static_tag>();
+  tests<dynamic_tag>();
+
+  return boost::report_errors();
+}
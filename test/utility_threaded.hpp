@@ -0,0 +1,82 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_TEST_UTILITY_THREADED_HPP
+#define BOOST_HISTOGRAM_TEST_UTILITY_THREADED_HPP
+
+#include <boost/core/lightweight_test.hpp>
+#include <boost/histogram/algorithm/sum.hpp>
+#include <boost/histogram/indexed.hpp>
+#include <boost/histogram/storage_adaptor.hpp>
+#include <boost/histogram/unsafe_access.hpp>
+#include <thread>
+#include <vector>
+#include "utility_histogram.hpp"
+
+namespace boost {
+namespace histogram {
+
+constexpr int n_threads = 4;
+
+// calls f(k) for k in [0, n_threads), each call in its own thread
+template <class F>
+void run_in_threads(F f) {
+  std::vector<std::thread> threads;
+  for (int k = 0; k < n_threads; ++k) threads.emplace_back(f, k);
+  for (auto&& t : threads) t.join();
+}
+
+/*
+  Fills a histogram with Storage from several threads, first value by value and then in
+  batches with weight 2, and compares it with a histogram filled serially. The functor
+  flush is called with the storage after the batches are filled, for storages which must
+  be flushed explicitly.
+*/
+template <class Tag, class Storage, class A1, class A2, class X, class Y, class Flush>
+void threaded_fill_test(const A1& a1, const A2& a2, const X& x, const Y& y,
+                        Flush flush) {
+  const auto n = static_cast<unsigned>(x.size());
+  auto h1 = make_s(Tag{}, dense_storage<int>(), a1, a2);
+  for (unsigned i = 0; i != n; ++i) h1(x[i], y[i]);
+  auto h2 = make_s(Tag{}, Storage(), a1, a2);
+  const auto shift = n / n_threads;
+  run_in_threads([&h2, &x, &y, shift](int k) {
+    auto xit = x.cbegin() + k * shift;
+    auto yit = y.cbegin() + k * shift;
+    for (unsigned i = 0; i < shift; ++i) h2(*xit++, *yit++);
+  });
+
+  BOOST_TEST_EQ(algorithm::sum(h2), n);
+  for (auto&& xi : indexed(h2, coverage::all))
+    BOOST_TEST_EQ(*xi, h1.at(xi.indices()));
+
+  run_in_threads([&h2, &x, &y, shift](int k) {
+    const auto b = k * shift;
+    h2.fill(std::vector<std::vector<int>>{{x.begin() + b, x.begin() + b + shift},
+                                          {y.begin() + b, y.begin() + b + shift}},
+            weight(std::vector<unsigned>(shift, 2)));
+  });
+  flush(unsafe_access::storage(h2));
+  BOOST_TEST_EQ(algorithm::sum(h2), 3 * n);
+  for (auto&& xi : indexed(h2, coverage::all))
+    BOOST_TEST_EQ(*xi, 3 * h1.at(xi.indices()));
+
+  // copies see all increments
+  run_in_threads([&h2, &x, &y](int k) { h2(x[k], y[k]); });
+  const auto h3 = h2;
+  BOOST_TEST_EQ(algorithm::sum(h3), 3 * n + n_threads);
+  BOOST_TEST_EQ(h3, h2);
+
+  h2.reset();
+  BOOST_TEST_EQ(algorithm::sum(h2), 0);
+  h2(x[0], y[0]);
+  BOOST_TEST_EQ(algorithm::sum(h2), 1);
+}
+
+} // namespace histogram
+} // namespace boost
+
+#endif